@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/Affinity.hpp
+/// @brief Declaration CPU set, CPU topology and thread affinity helpers.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "uni/common/Defines.hpp"
+#include "uni/common/ErrorCode.hpp"
+#include "uni/common/LogJson.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <ostream>
+#include <vector>
+
+namespace uni
+{
+namespace common
+{
+/// Sorted set of logical CPU indexes. Empty set means "no restrictions"
+class UNI_API CpuSet
+{
+public:
+    CpuSet( ) = default;
+
+    CpuSet( std::initializer_list< uint32_t > cpus )
+    {
+        for( const auto cpu : cpus )
+        {
+            add( cpu );
+        }
+    }
+
+    void
+    add( uint32_t cpu )
+    {
+        const auto it = std::lower_bound( m_cpus.begin( ), m_cpus.end( ), cpu );
+        if( ( it == m_cpus.end( ) ) || ( *it != cpu ) )
+        {
+            m_cpus.insert( it, cpu );
+        }
+    }
+
+    bool
+    contains( uint32_t cpu ) const
+    {
+        return std::binary_search( m_cpus.begin( ), m_cpus.end( ), cpu );
+    }
+
+    bool
+    empty( ) const noexcept
+    {
+        return m_cpus.empty( );
+    }
+
+    size_t
+    size( ) const noexcept
+    {
+        return m_cpus.size( );
+    }
+
+    const std::vector< uint32_t >&
+    cpus( ) const noexcept
+    {
+        return m_cpus;
+    }
+
+    bool
+    operator==( const CpuSet& other ) const
+    {
+        return m_cpus == other.m_cpus;
+    }
+
+    void
+    serialize_json( JsonWriter& writer ) const
+    {
+        write_json( writer, m_cpus );
+    }
+
+    friend std::ostream&
+    operator<<( std::ostream& out, const CpuSet& cpu_set )
+    {
+        out << "[";
+        for( size_t i = 0U; i < cpu_set.m_cpus.size( ); ++i )
+        {
+            out << ( i == 0U ? "" : "," ) << cpu_set.m_cpus[ i ];
+        }
+        out << "]";
+        return out;
+    }
+
+private:
+    std::vector< uint32_t > m_cpus{};
+};
+
+/// Location of the logical CPU
+struct CpuInfo
+{
+    uint32_t cpu{ 0U };      //< Logical CPU index
+    uint32_t core{ 0U };     //< Physical core id, unique within the package
+    uint32_t package{ 0U };  //< Socket
+    uint32_t node{ 0U };     //< NUMA node
+};
+
+/// Online CPUs sorted by node, package, core and logical index.
+/// Falls back to the flat topology of hardware_concurrency( ) CPUs when the system does not provide it
+std::vector< CpuInfo > get_cpu_topology( );
+
+/// CPUs of the NUMA node, empty if there is no such node
+CpuSet get_numa_node_cpus( uint32_t node );
+
+/// Pins the calling thread to the CPU set. Empty set resets the affinity to all the CPUs
+ErrorCode set_current_thread_affinity( const CpuSet& cpu_set );
+
+}  // namespace common
+}  // namespace uni
@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/Backoff.hpp
+/// @brief Declaration spin-then-yield backoff helper.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "uni/common/Defines.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <immintrin.h>
+#endif
+
+namespace uni
+{
+namespace common
+{
+/// Hint to the CPU that the thread is spinning
+inline void
+cpu_relax( ) noexcept
+{
+#if defined( __x86_64__ ) || defined( __i386__ )
+    _mm_pause( );
+#elif defined( __aarch64__ ) || defined( __arm__ )
+    asm volatile( "yield" ::: "memory" );
+#else
+    std::atomic_signal_fence( std::memory_order_seq_cst );
+#endif
+}
+
+/*
+ * Escalating wait: exponentially growing bursts of the pause instruction,
+ * then std::this_thread::yield( ). The caller decides what to do after that (usually blocks).
+ */
+class UNI_API Backoff
+{
+public:
+    Backoff( uint32_t spin_count, uint32_t yield_count ) noexcept
+        : m_spin_count{ spin_count }
+        , m_yield_count{ yield_count }
+    {
+    }
+
+    /// Returns false when spinning and yielding are exhausted
+    bool
+    pause( ) noexcept
+    {
+        if( m_step < m_spin_count )
+        {
+            const uint32_t burst = 1U << ( m_step < MAX_BURST_SHIFT ? m_step : MAX_BURST_SHIFT );
+            for( uint32_t i = 0U; i < burst; ++i )
+            {
+                cpu_relax( );
+            }
+        }
+        else if( m_step < m_spin_count + m_yield_count )
+        {
+            std::this_thread::yield( );
+        }
+        else
+        {
+            return false;
+        }
+
+        ++m_step;
+        return true;
+    }
+
+    void
+    reset( ) noexcept
+    {
+        m_step = 0U;
+    }
+
+private:
+    static constexpr uint32_t MAX_BURST_SHIFT{ 6U };
+
+    const uint32_t m_spin_count{ 0U };
+    const uint32_t m_yield_count{ 0U };
+    uint32_t m_step{ 0U };
+};
+
+}  // namespace common
+}  // namespace uni
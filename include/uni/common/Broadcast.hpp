@@ -206,7 +206,7 @@ public:
         {
             if( !m_dispatcher )
             {
-                LOG_FATAL_MSG( "Empty dispatcher" );
+                LOG_COMPONENT_FATAL_MSG( LogComponent::BROADCAST, "Empty dispatcher" );
                 return;
             }
 
@@ -242,7 +242,7 @@ public:
         {
             if( !m_sender )
             {
-                LOG_FATAL_MSG( "Empty sender" );
+                LOG_COMPONENT_FATAL_MSG( LogComponent::BROADCAST, "Empty sender" );
             }
         }
 
@@ -254,7 +254,7 @@ public:
         void
         notify_all( const BroadcastDataType& event )
         {
-            REQUIRED( m_sender, "Empty sender" );
+            REQUIRED_COMPONENT( LogComponent::BROADCAST, m_sender, "Empty sender" );
             Event< BroadcastDataType >::broadcast_event( event, *m_sender );
         }
 
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 namespace uni
@@ -20,5 +21,7 @@ constexpr uint32_t SECONDS_IN_MINUTE{ 60U };
 
 constexpr uint64_t DEFAULT_TIMEOUT_MS{ 50U };
 
+constexpr size_t CACHE_LINE_SIZE{ 64U };
+
 }  // namespace common
 }  // namespace uni
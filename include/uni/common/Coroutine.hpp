@@ -0,0 +1,583 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/Coroutine.hpp
+/// @brief Declaration C++20 coroutine task, combinators and awaitables on top of the thread pool.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "uni/common/Defines.hpp"
+#include "uni/common/Log.hpp"
+#include "uni/common/ThreadPool.hpp"
+
+#if defined( __cpp_impl_coroutine ) && __has_include( <coroutine> )
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace uni
+{
+namespace common
+{
+namespace coro
+{
+template < class T = void >
+class Task;
+
+namespace detail
+{
+/// void results are stored as std::monostate, so the combinators handle them uniformly
+template < class T >
+using NonVoid = std::conditional_t< std::is_void< T >::value, std::monostate, T >;
+
+/// Resumes the awaiting coroutine by symmetric transfer, so long co_await chains do not grow the stack
+struct FinalAwaiter
+{
+    bool
+    await_ready( ) const noexcept
+    {
+        return false;
+    }
+
+    template < class Promise >
+    std::coroutine_handle< >
+    await_suspend( std::coroutine_handle< Promise > handle ) noexcept
+    {
+        const auto continuation = handle.promise( ).get_continuation( );
+        return continuation ? continuation : std::noop_coroutine( );
+    }
+
+    void
+    await_resume( ) const noexcept
+    {
+    }
+};
+
+class PromiseBase
+{
+public:
+    /// Tasks are lazy: the body starts when the task is awaited
+    std::suspend_always
+    initial_suspend( ) const noexcept
+    {
+        return {};
+    }
+
+    FinalAwaiter
+    final_suspend( ) const noexcept
+    {
+        return {};
+    }
+
+    void
+    unhandled_exception( ) noexcept
+    {
+        m_exception = std::current_exception( );
+    }
+
+    void
+    set_continuation( std::coroutine_handle< > continuation ) noexcept
+    {
+        m_continuation = continuation;
+    }
+
+    std::coroutine_handle< >
+    get_continuation( ) const noexcept
+    {
+        return m_continuation;
+    }
+
+protected:
+    void
+    rethrow_if_failed( ) const
+    {
+        if( m_exception )
+        {
+            std::rethrow_exception( m_exception );
+        }
+    }
+
+private:
+    std::coroutine_handle< > m_continuation{};
+    std::exception_ptr m_exception{};
+};
+
+template < class T >
+class Promise : public PromiseBase
+{
+public:
+    Task< T > get_return_object( ) noexcept;
+
+    template < class U >
+    void
+    return_value( U&& value )
+    {
+        m_value.emplace( std::forward< U >( value ) );
+    }
+
+    T
+    get_result( )
+    {
+        rethrow_if_failed( );
+        return std::move( *m_value );
+    }
+
+private:
+    std::optional< T > m_value{};
+};
+
+template <>
+class Promise< void > : public PromiseBase
+{
+public:
+    Task< void > get_return_object( ) noexcept;
+
+    void
+    return_void( ) const noexcept
+    {
+    }
+
+    void
+    get_result( ) const
+    {
+        rethrow_if_failed( );
+    }
+};
+}  // namespace detail
+
+/*
+ * Lazy coroutine returning T. co_await on the task starts it and resumes the awaiting
+ * coroutine when it finishes, on the thread that finished it. Exceptions are rethrown to the awaiting side.
+ * Use co_await pool.schedule( ) inside the coroutine to move it to the pool.
+ */
+template < class T >
+class Task
+{
+    static_assert( !std::is_reference< T >::value, "Task of reference is not supported" );
+
+public:
+    using promise_type = detail::Promise< T >;
+    using Handle = std::coroutine_handle< promise_type >;
+
+public:
+    Task( ) noexcept = default;
+
+    explicit Task( Handle handle ) noexcept
+        : m_handle{ handle }
+    {
+    }
+
+    Task( Task&& other ) noexcept
+        : m_handle{ std::exchange( other.m_handle, nullptr ) }
+    {
+    }
+
+    Task&
+    operator=( Task&& other ) noexcept
+    {
+        if( this != &other )
+        {
+            destroy( );
+            m_handle = std::exchange( other.m_handle, nullptr );
+        }
+        return *this;
+    }
+
+    Task( const Task& ) = delete;
+    Task& operator=( const Task& ) = delete;
+
+    ~Task( )
+    {
+        destroy( );
+    }
+
+    bool
+    valid( ) const noexcept
+    {
+        return static_cast< bool >( m_handle );
+    }
+
+    /// The task must be valid and awaited once
+    auto operator co_await( ) && noexcept
+    {
+        struct Awaiter
+        {
+            Handle m_handle;
+
+            bool
+            await_ready( ) const noexcept
+            {
+                return m_handle.done( );
+            }
+
+            std::coroutine_handle< >
+            await_suspend( std::coroutine_handle< > awaiting ) noexcept
+            {
+                m_handle.promise( ).set_continuation( awaiting );
+                return m_handle;
+            }
+
+            T
+            await_resume( )
+            {
+                return m_handle.promise( ).get_result( );
+            }
+        };
+
+        return Awaiter{ m_handle };
+    }
+
+private:
+    void
+    destroy( ) noexcept
+    {
+        if( m_handle )
+        {
+            m_handle.destroy( );
+            m_handle = nullptr;
+        }
+    }
+
+private:
+    Handle m_handle{};
+};
+
+namespace detail
+{
+template < class T >
+Task< T >
+Promise< T >::get_return_object( ) noexcept
+{
+    return Task< T >{ std::coroutine_handle< Promise< T > >::from_promise( *this ) };
+}
+
+inline Task< void >
+Promise< void >::get_return_object( ) noexcept
+{
+    return Task< void >{ std::coroutine_handle< Promise< void > >::from_promise( *this ) };
+}
+
+/// Eagerly started coroutine that destroys its frame when finished, the driver of the combinators
+struct DetachedTask
+{
+    struct promise_type
+    {
+        DetachedTask
+        get_return_object( ) const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never
+        initial_suspend( ) const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never
+        final_suspend( ) const noexcept
+        {
+            return {};
+        }
+
+        void
+        return_void( ) const noexcept
+        {
+        }
+
+        void
+        unhandled_exception( ) const noexcept
+        {
+            std::terminate( );
+        }
+    };
+};
+
+/// Result or exception of one child of the combinator
+template < class T >
+struct Slot
+{
+    std::optional< NonVoid< T > > value{};
+    std::exception_ptr exception{};
+
+    NonVoid< T >
+    take( )
+    {
+        if( exception )
+        {
+            std::rethrow_exception( exception );
+        }
+        return std::move( *value );
+    }
+};
+
+/*
+ * Counts down the finished children. The awaiting coroutine holds one extra count,
+ * so whoever comes last (a child or the awaiting coroutine itself) continues it.
+ */
+class Latch
+{
+public:
+    explicit Latch( size_t count ) noexcept
+        : m_count{ count + 1U }
+    {
+    }
+
+    void
+    arrive( ) noexcept
+    {
+        if( 1U == m_count.fetch_sub( 1U, std::memory_order_acq_rel ) )
+        {
+            m_continuation.resume( );
+        }
+    }
+
+    bool
+    await_ready( ) const noexcept
+    {
+        return false;
+    }
+
+    bool
+    await_suspend( std::coroutine_handle< > continuation ) noexcept
+    {
+        m_continuation = continuation;
+        return 1U != m_count.fetch_sub( 1U, std::memory_order_acq_rel );
+    }
+
+    void
+    await_resume( ) const noexcept
+    {
+    }
+
+private:
+    std::atomic< size_t > m_count{ 0U };
+    std::coroutine_handle< > m_continuation{};
+};
+
+/// Blocks the calling thread until the child arrives
+class Event
+{
+public:
+    void
+    arrive( )
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        m_is_set = true;
+        m_cv.notify_one( );
+    }
+
+    void
+    wait( )
+    {
+        std::unique_lock< std::mutex > lock( m_mutex );
+        m_cv.wait( lock, [ this ] { return m_is_set; } );
+    }
+
+private:
+    std::mutex m_mutex{};
+    std::condition_variable m_cv{};
+    bool m_is_set{ false };
+};
+
+template < class T, class Notifier >
+DetachedTask
+run_child( Task< T > task, Slot< T >& slot, Notifier& notifier )
+{
+    try
+    {
+        if constexpr( std::is_void< T >::value )
+        {
+            co_await std::move( task );
+            slot.value.emplace( );
+        }
+        else
+        {
+            slot.value.emplace( co_await std::move( task ) );
+        }
+    }
+    catch( ... )
+    {
+        slot.exception = std::current_exception( );
+    }
+
+    // The finished frame is destroyed first: once the notifier lets the awaiting side go on, the frame must not refer to it
+    task = Task< T >{ };
+    notifier.arrive( );
+}
+
+template < class T >
+struct WhenAnyState
+{
+    std::atomic< bool > is_finished{ false };
+    Latch latch{ 1U };
+    size_t index{ 0U };
+    Slot< T > slot{};
+};
+
+template < class T >
+DetachedTask
+run_when_any_child( Task< T > task, size_t index, std::shared_ptr< WhenAnyState< T > > state )
+{
+    Slot< T > slot;
+    try
+    {
+        if constexpr( std::is_void< T >::value )
+        {
+            co_await std::move( task );
+            slot.value.emplace( );
+        }
+        else
+        {
+            slot.value.emplace( co_await std::move( task ) );
+        }
+    }
+    catch( ... )
+    {
+        slot.exception = std::current_exception( );
+    }
+
+    if( !state->is_finished.exchange( true, std::memory_order_acq_rel ) )
+    {
+        state->index = index;
+        state->slot = std::move( slot );
+        state->latch.arrive( );
+    }
+}
+
+inline DetachedTask
+run_spawned( Task< void > task )
+{
+    try
+    {
+        co_await std::move( task );
+    }
+    catch( const std::exception& exception )
+    {
+        LOG_COMPONENT_ERROR_MSG( LogComponent::POOL, "Spawned coroutine failed: ", exception.what( ) );
+    }
+    catch( ... )
+    {
+        LOG_COMPONENT_ERROR_MSG( LogComponent::POOL, "Spawned coroutine failed" );
+    }
+}
+}  // namespace detail
+
+/// Runs the tasks concurrently (each one up to its first suspension on the calling thread) and waits for all of them.
+/// Rethrows the exception of the first failed task in argument order
+template < class... Ts >
+Task< std::tuple< detail::NonVoid< Ts >... > >
+when_all( Task< Ts >... tasks )
+{
+    detail::Latch latch{ sizeof...( Ts ) };
+    std::tuple< detail::Slot< Ts >... > slots;
+
+    [ & ]< size_t... I >( std::index_sequence< I... > ) {
+        ( detail::run_child( std::move( tasks ), std::get< I >( slots ), latch ), ... );
+    }( std::index_sequence_for< Ts... >{ } );
+    co_await latch;
+
+    co_return std::apply( []( auto&... slot ) { return std::tuple< detail::NonVoid< Ts >... >( slot.take( )... ); }, slots );
+}
+
+/// Same as the variadic when_all( ) for the tasks of the same type, results are in the task order
+template < class T >
+Task< std::vector< detail::NonVoid< T > > >
+when_all( std::vector< Task< T > > tasks )
+{
+    detail::Latch latch{ tasks.size( ) };
+    std::vector< detail::Slot< T > > slots( tasks.size( ) );
+
+    for( size_t i = 0U; i < tasks.size( ); ++i )
+    {
+        detail::run_child( std::move( tasks[ i ] ), slots[ i ], latch );
+    }
+    co_await latch;
+
+    std::vector< detail::NonVoid< T > > results;
+    results.reserve( slots.size( ) );
+    for( auto& slot : slots )
+    {
+        results.push_back( slot.take( ) );
+    }
+    co_return results;
+}
+
+/// Runs the tasks concurrently and returns the index and the result of the first finished one.
+/// The rest keep running to completion, their results are dropped. Throws std::invalid_argument on empty input
+template < class T >
+Task< std::pair< size_t, detail::NonVoid< T > > >
+when_any( std::vector< Task< T > > tasks )
+{
+    if( tasks.empty( ) )
+    {
+        throw std::invalid_argument( "when_any( ) of no tasks" );
+    }
+
+    // Shared with the children that outlive the awaiting coroutine
+    auto state = std::make_shared< detail::WhenAnyState< T > >( );
+    for( size_t i = 0U; i < tasks.size( ); ++i )
+    {
+        detail::run_when_any_child( std::move( tasks[ i ] ), i, state );
+    }
+    co_await state->latch;
+
+    co_return std::make_pair( state->index, state->slot.take( ) );
+}
+
+using SleepAwaiter = ThreadPool::SleepAwaiter;
+
+/// co_await sleep_for( pool, 10ms ) suspends on the timer wheel of the pool without occupying a worker.
+/// Throws std::future_error( broken_promise ) in the coroutine still sleeping when the pool is shut down
+template < class Rep, class Period >
+SleepAwaiter
+sleep_for( ThreadPool& pool, std::chrono::duration< Rep, Period > duration )
+{
+    return SleepAwaiter{ pool, std::chrono::duration_cast< ThreadPool::Clock::duration >( duration ) };
+}
+
+/// Starts the task on the calling thread without waiting, exceptions are logged
+inline void
+spawn( Task< void > task )
+{
+    detail::run_spawned( std::move( task ) );
+}
+
+/// Blocks the calling thread until the task finishes. Must not be called from a worker of the pool the task runs on
+template < class T >
+T
+sync_wait( Task< T > task )
+{
+    detail::Event event;
+    detail::Slot< T > slot;
+    detail::run_child( std::move( task ), slot, event );
+    event.wait( );
+
+    if constexpr( std::is_void< T >::value )
+    {
+        slot.take( );
+    }
+    else
+    {
+        return slot.take( );
+    }
+}
+
+}  // namespace coro
+}  // namespace common
+}  // namespace uni
+
+#endif
@@ -7,9 +7,22 @@
 
 #pragma once
 
+#include "uni/common/Defines.hpp"
+#include "uni/common/ErrorCode.hpp"
+#include "uni/common/LogBinary.hpp"
+#include "uni/common/LogJson.hpp"
+#include "uni/common/LogLimiter.hpp"
+#include "uni/common/LogSink.hpp"
+
+#include <atomic>
+#include <cstdint>
 #include <iostream>
+#include <memory>
 #include <mutex>
+#include <sstream>
+#include <string>
 #include <thread>
+#include <vector>
 
 #define LOG_ENUM( EnumClass, ... )                                                                             \
     inline std::string stringify( EnumClass enum_class, const char* name, EnumClass value )                    \
@@ -23,6 +36,23 @@
         return ( enum_class != value ) ? stringify( enum_class, args... ) : "\"" + std::string( name ) + "\""; \
     }                                                                                                          \
                                                                                                                \
+    inline const char* enum_name( EnumClass enum_class, const char* name, EnumClass value )                    \
+    {                                                                                                          \
+        return ( enum_class != value ) ? nullptr : name;                                                       \
+    }                                                                                                          \
+                                                                                                               \
+    template < class... Args >                                                                                 \
+    inline const char* enum_name( EnumClass enum_class, const char* name, EnumClass value, Args... args )      \
+    {                                                                                                          \
+        return ( enum_class != value ) ? enum_name( enum_class, args... ) : name;                              \
+    }                                                                                                          \
+                                                                                                               \
+    /* Used by write_json( ), nullptr for the unknown value */                                                 \
+    inline const char* enum_name( EnumClass enum_class )                                                       \
+    {                                                                                                          \
+        return enum_name( enum_class, __VA_ARGS__ );                                                           \
+    }                                                                                                          \
+                                                                                                               \
     inline std::ostream& operator<<( std::ostream& out, EnumClass enum_class )                                 \
     {                                                                                                          \
         out << stringify( enum_class, __VA_ARGS__ );                                                           \
@@ -31,6 +61,16 @@
 
 #define LOG_E( x ) #x, x
 
+/// Most verbose level compiled in, 0 (FATAL) ... 5 (TRACE). The calls above it compile to nothing
+#ifndef UNI_LOG_MAX_LEVEL
+#define UNI_LOG_MAX_LEVEL 5
+#endif
+
+/// Component of the log calls in the translation unit, define it before the first include to change
+#ifndef UNI_LOG_COMPONENT
+#define UNI_LOG_COMPONENT ::uni::common::LogComponent::GENERAL
+#endif
+
 namespace uni
 {
 namespace common
@@ -49,33 +89,141 @@ enum class LogLevel : uint16_t
 
 LOG_ENUM( LogLevel, LOG_E( LogLevel::FATAL ), LOG_E( LogLevel::ERROR ), LOG_E( LogLevel::WARNING ), LOG_E( LogLevel::INFO ), LOG_E( LogLevel::DEBUG ), LOG_E( LogLevel::TRACE ) );
 
+/// Part of the library the record comes from, every component has its own runtime level
+enum class LogComponent : uint16_t
+{
+    GENERAL = 0U,
+    THREAD,
+    POOL,
+    BROADCAST,
+
+    COUNT  //< Maximum value, used for range check
+};
+
+LOG_ENUM( LogComponent, LOG_E( LogComponent::GENERAL ), LOG_E( LogComponent::THREAD ), LOG_E( LogComponent::POOL ), LOG_E( LogComponent::BROADCAST ) );
+
+/// Runtime levels of the components. Constant initialized, so usable from any static constructor or destructor
+extern UNI_API std::atomic< LogLevel > g_log_levels[ static_cast< size_t >( LogComponent::COUNT ) ];
+
+/// The whole cost of the filtered out call: one relaxed load and one branch
+inline bool
+is_log_enabled( LogComponent component, LogLevel level ) noexcept
+{
+    return level <= g_log_levels[ static_cast< size_t >( component ) ].load( std::memory_order_relaxed );
+}
+
+/// What the caller does when the async log buffer is full
+enum class LogOverflowPolicy : uint16_t
+{
+    BLOCK,  //< Waits for the writer, nothing is lost
+    DROP,   //< Drops the record and counts it, the writer reports the count
+};
+
+LOG_ENUM( LogOverflowPolicy, LOG_E( LogOverflowPolicy::BLOCK ), LOG_E( LogOverflowPolicy::DROP ) );
+
+/*
+ * Synchronous by default: the record is written to the sink (std::cout unless set_sink( ) is called)
+ * by the calling thread, the sink is flushed only for FATAL records and by flush( ).
+ * After start_async( ) the callers only format the record and push it to the lock-free buffer,
+ * the writer thread batches the records into large writes and flushes the stream every flush_interval_ms.
+ * FATAL records, flush( ), stop_async( ) and the logger destruction write out everything buffered.
+ * In the binary async mode the callers do not format at all: the arguments are copied into the thread's own
+ * SPSC buffer as BinaryLogRecord and formatted by the writer. The order is kept per thread.
+ */
 class Log
 {
 public:
-    void
-    set_max_log_level( LogLevel level )
+    struct AsyncSettings
     {
-        m_max_level = level;
-    }
+        size_t capacity{ 8192U };             //< Records buffered between the callers and the writer
+        size_t batch_size{ 64U * 1024U };     //< Bytes collected for one write
+        uint64_t flush_interval_ms{ 100U };  //< Longest time a written record stays in the stream buffer
+        LogOverflowPolicy overflow_policy{ LogOverflowPolicy::BLOCK };
+        bool is_binary{ false };             //< Format on the writer thread
+        size_t thread_capacity{ 1024U };     //< Binary records buffered per logging thread
+    };
+
+public:
+    Log( );
+    ~Log( );
+
+    /// Sets the level of every component
+    void set_max_log_level( LogLevel level );
+
+    void set_log_level( LogComponent component, LogLevel level );
 
+    LogLevel get_log_level( LogComponent component ) const;
+
+    /// func has to be the static string, __PRETTY_FUNCTION__ of the caller. The level is checked by the LOG_ macros
     template < class... Args >
     void
     log_msg( LogLevel level, const char* func, const Args&... args )
     {
-        if( level <= m_max_level )
+        if( m_is_binary.load( std::memory_order_acquire ) )
+        {
+            BinaryLogRecord record;
+            record.func = func;
+            record.level = static_cast< uint16_t >( level );
+            binary_log::encode_record( record, args... );
+            if( write_binary( record ) )
+            {
+                return;
+            }
+            record.decoder( nullptr, record.payload );
+        }
+
+        // Formatted into the thread's own line outside of any lock, only the finished line is copied to the stream or the writer
+        if( std::ostream* staging = begin_line( level, func ) )
         {
-            std::lock_guard< std::mutex > lock( m_mutex );
-            m_ostream << "\""
-                      << "Thread:" << std::this_thread::get_id( ) << "\""
-                      << " ";
-            m_ostream << level << " ";
-            m_ostream << "\"" << func << "\""
-                      << " ";
-            append( m_ostream, args... );
+            append( *staging, args... );
+            commit_line( level );
+            return;
         }
+
+        // Nested call from operator<< of an argument or the thread is exiting
+        std::ostringstream ostream;
+        write_header( ostream, level, func );
+        append( ostream, args... );
+        std::string line = ostream.str( );
+        write( level, line );
     }
 
+    /// INTERNAL if the async mode is already on
+    ErrorCode start_async( const AsyncSettings& settings );
+
+    /// Writes out the buffered records and returns to the synchronous mode.
+    /// The stopped writer is kept until the logger is destroyed, a concurrent caller might still be inside it
+    ErrorCode stop_async( );
+
+    bool is_async( ) const;
+
+    /// Writes out the buffered records and flushes the stream
+    void flush( );
+
+    /// Records dropped by LogOverflowPolicy::DROP
+    uint64_t get_dropped_count( ) const;
+
+    /// Waits for the write in progress, then the previous sink is flushed and released
+    ErrorCode set_sink( std::shared_ptr< LogSink > sink );
+
 private:
+    class AsyncWriter;
+
+    /// The async mode takes the line and leaves a spare one of the same kind in its place
+    void write( LogLevel level, std::string& line );
+
+    /// False if the record has to be written as the text, the caller still owns the record then
+    bool write_binary( BinaryLogRecord& record );
+
+    /// Thread, level and function of the record
+    static void write_header( std::ostream& ostream, LogLevel level, const char* func );
+
+    /// Clears the thread's staging line and writes the header, nullptr if the line is not available
+    static std::ostream* begin_line( LogLevel level, const char* func );
+
+    /// Writes the staging line of the thread, started by begin_line( )
+    void commit_line( LogLevel level );
+
     template < class T, class... Args >
     inline void
     append( std::ostream& ostream, const T& value, const Args&... args )
@@ -88,27 +236,93 @@ private:
     inline void
     append( std::ostream& ostream, const T& value )
     {
-        ostream << value << std::endl;
+        ostream << value << '\n';
     }
 
-    std::mutex m_mutex{};
-    std::ostream& m_ostream{ std::cout };
-    LogLevel m_max_level{ LogLevel::DEBUG };
+    std::mutex m_mutex{};                    //< Serializes the writes to the sink, the sink is loaded under it
+    std::atomic< LogSink* > m_sink{ nullptr };
+
+    std::mutex m_sink_mutex{};  //< Serializes set_sink( )
+    std::shared_ptr< LogSink > m_sink_holder{};
+
+    mutable std::mutex m_async_mutex{};  //< Serializes start_async( ) and stop_async( )
+    std::atomic< AsyncWriter* > m_async_writer{ nullptr };
+    std::atomic< bool > m_is_binary{ false };
+    std::unique_ptr< AsyncWriter > m_writer_holder{};
+    std::vector< std::unique_ptr< AsyncWriter > > m_retired_writers{};  //< Stopped, kept with the logger: the callers are not counted
 };
 
 Log& logger( );
 
+/// Name of the calling thread in its log records, set by set_current_thread_name( )
+void set_log_thread_name( const std::string& name );
+
 }  // namespace common
 }  // namespace uni
 
-#define LOG_MSG( ... ) uni::common::logger( ).log_msg( __VA_ARGS__ )
+// The compile-time check is a constant expression, the optimizer removes the whole call together with the arguments
+#define LOG_IS_ON( component, level ) \
+    ( ( static_cast< int >( level ) <= UNI_LOG_MAX_LEVEL ) && ::uni::common::is_log_enabled( component, level ) )
+
+#define LOG_COMPONENT_MSG( component, level, ... )                  \
+    do                                                              \
+    {                                                               \
+        if( LOG_IS_ON( component, level ) )                         \
+        {                                                           \
+            ::uni::common::logger( ).log_msg( level, __VA_ARGS__ ); \
+        }                                                           \
+    } while( false )
 
-#define LOG_FATAL_MSG( ... )   LOG_MSG( uni::common::LogLevel::FATAL, static_cast< const char* >( __PRETTY_FUNCTION__ ), __VA_ARGS__ )
-#define LOG_ERROR_MSG( ... )   LOG_MSG( uni::common::LogLevel::ERROR, static_cast< const char* >( __PRETTY_FUNCTION__ ), __VA_ARGS__ )
-#define LOG_WARNING_MSG( ... ) LOG_MSG( uni::common::LogLevel::WARNING, static_cast< const char* >( __PRETTY_FUNCTION__ ), __VA_ARGS__ )
-#define LOG_INFO_MSG( ... )    LOG_MSG( uni::common::LogLevel::INFO, static_cast< const char* >( __PRETTY_FUNCTION__ ), __VA_ARGS__ )
-#define LOG_DEBUG_MSG( ... )   LOG_MSG( uni::common::LogLevel::DEBUG, static_cast< const char* >( __PRETTY_FUNCTION__ ), __VA_ARGS__ )
-#define LOG_TRACE_MSG( ... )   LOG_MSG( uni::common::LogLevel::TRACE, static_cast< const char* >( __PRETTY_FUNCTION__ ), __VA_ARGS__ )
+#define LOG_MSG( level, ... ) LOG_COMPONENT_MSG( UNI_LOG_COMPONENT, level, __VA_ARGS__ )
+
+#define LOG_FATAL_MSG( ... )   LOG_MSG( ::uni::common::LogLevel::FATAL, static_cast< const char* >( __PRETTY_FUNCTION__ ), __VA_ARGS__ )
+#define LOG_ERROR_MSG( ... )   LOG_MSG( ::uni::common::LogLevel::ERROR, static_cast< const char* >( __PRETTY_FUNCTION__ ), __VA_ARGS__ )
+#define LOG_WARNING_MSG( ... ) LOG_MSG( ::uni::common::LogLevel::WARNING, static_cast< const char* >( __PRETTY_FUNCTION__ ), __VA_ARGS__ )
+#define LOG_INFO_MSG( ... )    LOG_MSG( ::uni::common::LogLevel::INFO, static_cast< const char* >( __PRETTY_FUNCTION__ ), __VA_ARGS__ )
+#define LOG_DEBUG_MSG( ... )   LOG_MSG( ::uni::common::LogLevel::DEBUG, static_cast< const char* >( __PRETTY_FUNCTION__ ), __VA_ARGS__ )
+#define LOG_TRACE_MSG( ... )   LOG_MSG( ::uni::common::LogLevel::TRACE, static_cast< const char* >( __PRETTY_FUNCTION__ ), __VA_ARGS__ )
+
+// Inline and template code of the headers names its component: UNI_LOG_COMPONENT differs between the translation units
+#define LOG_COMPONENT_FATAL_MSG( component, ... ) \
+    LOG_COMPONENT_MSG( component, ::uni::common::LogLevel::FATAL, static_cast< const char* >( __PRETTY_FUNCTION__ ), __VA_ARGS__ )
+#define LOG_COMPONENT_ERROR_MSG( component, ... ) \
+    LOG_COMPONENT_MSG( component, ::uni::common::LogLevel::ERROR, static_cast< const char* >( __PRETTY_FUNCTION__ ), __VA_ARGS__ )
+#define LOG_COMPONENT_WARNING_MSG( component, ... ) \
+    LOG_COMPONENT_MSG( component, ::uni::common::LogLevel::WARNING, static_cast< const char* >( __PRETTY_FUNCTION__ ), __VA_ARGS__ )
+
+// Per-callsite limits, level is the name: LOG_EVERY_MS( ERROR, 1000, "Connection failed: ", error ).
+// The limiter is touched only if the level is on, the allowed record tells how many calls were suppressed before it
+#define LOG_LIMITED_MSG( level, Limiter, limiter_args, ... )                                                                      \
+    do                                                                                                                            \
+    {                                                                                                                             \
+        if( LOG_IS_ON( UNI_LOG_COMPONENT, ::uni::common::LogLevel::level ) )                                                      \
+        {                                                                                                                         \
+            static ::uni::common::Limiter s_log_limiter limiter_args;                                                             \
+            uint64_t log_suppressed_count{ 0U };                                                                                  \
+            if( s_log_limiter.allow( log_suppressed_count ) )                                                                     \
+            {                                                                                                                     \
+                if( 0U == log_suppressed_count )                                                                                  \
+                {                                                                                                                 \
+                    ::uni::common::logger( ).log_msg(                                                                             \
+                        ::uni::common::LogLevel::level, static_cast< const char* >( __PRETTY_FUNCTION__ ), __VA_ARGS__ );         \
+                }                                                                                                                 \
+                else                                                                                                              \
+                {                                                                                                                 \
+                    ::uni::common::logger( ).log_msg( ::uni::common::LogLevel::level,                                             \
+                                                      static_cast< const char* >( __PRETTY_FUNCTION__ ),                          \
+                                                      __VA_ARGS__,                                                                \
+                                                      " (suppressed: ",                                                           \
+                                                      log_suppressed_count,                                                       \
+                                                      ")" );                                                                      \
+                }                                                                                                                 \
+            }                                                                                                                     \
+        }                                                                                                                         \
+    } while( false )
+
+#define LOG_EVERY_N( level, n, ... )                    LOG_LIMITED_MSG( level, LogEveryN, ( n ), __VA_ARGS__ )
+#define LOG_FIRST_N( level, n, ... )                    LOG_LIMITED_MSG( level, LogFirstN, ( n ), __VA_ARGS__ )
+#define LOG_EVERY_MS( level, period_ms, ... )           LOG_LIMITED_MSG( level, LogEveryMs, ( period_ms ), __VA_ARGS__ )
+#define LOG_RATE_LIMITED( level, per_second, burst, ... ) LOG_LIMITED_MSG( level, LogTokenBucket, ( per_second, burst ), __VA_ARGS__ )
 
 #define REQUIRED_RETVAL( condition, msg, return_value ) \
     if( !( condition ) )                                \
@@ -123,40 +337,44 @@ Log& logger( );
 #define GET_MACRO( _1, _2, _3, MACRO, ... ) MACRO
 #define REQUIRED( ... )                     GET_MACRO( __VA_ARGS__, REQUIRED_RETVAL, REQUIRED_VOID )( __VA_ARGS__ )
 
-#define LOG_IT( x ) #x, x
+/// REQUIRED for the paths that might fail in a storm: the message is logged at most once a second per call site
+#define REQUIRED_LIMITED_RETVAL( condition, msg, return_value ) \
+    if( !( condition ) )                                        \
+    {                                                           \
+        LOG_EVERY_MS( ERROR, 1000U, msg );                      \
+        return ( return_value );                                \
+    }
 
-template < class T >
-inline void
-merge_key_value_pairs( std::ostream& out, const char* key, const T& value )
-{
-    out << R"(")" << key << R"(":)";
-    out << value;
-    out << "";
-}
+#define REQUIRED_LIMITED_VOID( condition, msg ) REQUIRED_LIMITED_RETVAL( ( condition ), ( msg ), void( ) )
+#define REQUIRED_LIMITED( ... )                 GET_MACRO( __VA_ARGS__, REQUIRED_LIMITED_RETVAL, REQUIRED_LIMITED_VOID )( __VA_ARGS__ )
 
-template < class T, class... Args >
-inline void
-merge_key_value_pairs( std::ostream& out, const char* key, const T& value, const Args&... args )
-{
-    out << R"(")" << key << R"(":)";
-    out << value;
-    out << ",";
-    merge_key_value_pairs( out, args... );
-}
+/// REQUIRED of the inline and template code of the headers, see LOG_COMPONENT_ERROR_MSG( )
+#define REQUIRED_COMPONENT_RETVAL( component, condition, msg, return_value ) \
+    if( !( condition ) )                                                     \
+    {                                                                        \
+        LOG_COMPONENT_ERROR_MSG( component, msg );                           \
+        return ( return_value );                                             \
+    }
 
-template < class... Args >
-inline void
-serialization( std::ostream& out, const Args&... args )
-{
-    out << "{";
-    merge_key_value_pairs( out, args... );
-    out << "}";
-}
+#define REQUIRED_COMPONENT_VOID( component, condition, msg ) REQUIRED_COMPONENT_RETVAL( component, ( condition ), ( msg ), void( ) )
+#define REQUIRED_COMPONENT( component, ... ) \
+    GET_MACRO( __VA_ARGS__, REQUIRED_COMPONENT_RETVAL, REQUIRED_COMPONENT_VOID )( component, __VA_ARGS__ )
 
+#define LOG_IT( x ) #x, x
+
+// JSON of the listed members: serialize_json( ) writes it into the caller's buffer without allocations,
+// operator<< goes through a stack buffer
 #define LOG_CLASS( Class, ... )                                                      \
+    inline void serialize_json( ::uni::common::JsonWriter& writer ) const            \
+    {                                                                                \
+        writer.write_char( '{' );                                                    \
+        ::uni::common::write_json_fields( writer, __VA_ARGS__ );                     \
+        writer.write_char( '}' );                                                    \
+    }                                                                                \
+                                                                                     \
     inline void serialize_me( std::ostream& out ) const                              \
     {                                                                                \
-        serialization( out, __VA_ARGS__ );                                           \
+        ::uni::common::print_json( out, *this );                                     \
     }                                                                                \
                                                                                      \
     friend inline std::ostream& operator<<( std::ostream& stream, const Class& obj ) \
@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/LogBinary.hpp
+/// @brief Declaration binary log record and its argument codec.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+namespace uni
+{
+namespace common
+{
+/*
+ * Log record with the raw arguments, formatted later by the log writer.
+ * The decoder is instantiated for the argument types of the call, together with the function name
+ * it is the static descriptor of the record: the caller copies bytes and formats nothing.
+ * The decoder is called exactly once per record: to print it or, with nullptr, to discard it.
+ */
+struct BinaryLogRecord
+{
+    using Decoder = void ( * )( std::ostream* out, const unsigned char* payload );
+
+    static constexpr size_t PAYLOAD_SIZE{ 216U };  //< The record takes 256 bytes
+
+    Decoder decoder{ nullptr };
+    const char* func{ nullptr };
+    const char* thread_name{ nullptr };  //< Interned by the logger, valid until the process exit
+    std::thread::id thread_id{};
+    uint16_t level{ 0U };
+    uint16_t size{ 0U };
+    unsigned char payload[ PAYLOAD_SIZE ];
+};
+
+namespace binary_log
+{
+/*
+ * How the argument is stored:
+ * strings and string views - length and characters, numbers and enums - raw bytes,
+ * everything else is formatted by the caller and stored as the string.
+ * Raw bytes are read when the writer formats the record: a type that refers to the caller's memory
+ * (a pointer, a view, a struct with a const char* member) would dangle by then, so only the types
+ * that own their whole value go raw. A plain struct can opt in with
+ * template <> constexpr bool binary_log::ALLOW_RAW< MyStruct > = true;
+ */
+template < class T >
+constexpr bool ALLOW_RAW = false;
+
+template < class T >
+constexpr bool IS_STRING = std::is_same< T, std::string >::value || std::is_same< T, std::string_view >::value
+                           || std::is_same< std::decay_t< T >, const char* >::value || std::is_same< std::decay_t< T >, char* >::value;
+
+template < class T >
+constexpr bool IS_RAW = !IS_STRING< T > && ( std::is_arithmetic< T >::value || std::is_enum< T >::value || ALLOW_RAW< T > );
+
+class Writer
+{
+public:
+    explicit Writer( BinaryLogRecord& record ) noexcept
+        : m_record{ record }
+    {
+    }
+
+    void
+    write( const void* data, size_t size ) noexcept
+    {
+        if( m_is_overflow || ( m_size + size > BinaryLogRecord::PAYLOAD_SIZE ) )
+        {
+            m_is_overflow = true;
+            return;
+        }
+        std::memcpy( m_record.payload + m_size, data, size );
+        m_size += size;
+    }
+
+    void
+    write_string( const char* data, size_t size ) noexcept
+    {
+        const auto length = static_cast< uint16_t >( size );
+        if( length != size )
+        {
+            m_is_overflow = true;
+            return;
+        }
+        write( &length, sizeof( length ) );
+        write( data, size );
+    }
+
+    /// False if the arguments do not fit the record
+    bool
+    finish( ) noexcept
+    {
+        m_record.size = static_cast< uint16_t >( m_size );
+        return !m_is_overflow;
+    }
+
+private:
+    BinaryLogRecord& m_record;
+    size_t m_size{ 0U };
+    bool m_is_overflow{ false };
+};
+
+class Reader
+{
+public:
+    explicit Reader( const unsigned char* payload ) noexcept
+        : m_data{ payload }
+    {
+    }
+
+    void
+    read( void* data, size_t size ) noexcept
+    {
+        std::memcpy( data, m_data, size );
+        m_data += size;
+    }
+
+    void
+    print_string( std::ostream& out ) noexcept
+    {
+        uint16_t length{ 0U };
+        read( &length, sizeof( length ) );
+        out.write( reinterpret_cast< const char* >( m_data ), length );
+        m_data += length;
+    }
+
+private:
+    const unsigned char* m_data{ nullptr };
+};
+
+template < class T >
+void
+encode( Writer& writer, const T& value )
+{
+    if constexpr( std::is_array< T >::value )
+    {
+        // Not necessary a literal, the characters are copied
+        writer.write_string( value, ::strnlen( value, sizeof( T ) ) );
+    }
+    else if constexpr( std::is_same< T, std::string >::value || std::is_same< T, std::string_view >::value )
+    {
+        writer.write_string( value.data( ), value.size( ) );
+    }
+    else if constexpr( IS_STRING< T > )
+    {
+        const char* string = ( nullptr != value ) ? value : "(null)";
+        writer.write_string( string, std::strlen( string ) );
+    }
+    else if constexpr( IS_RAW< T > )
+    {
+        static_assert( std::is_trivially_copyable< T >::value, "Only trivially copyable types can be stored as raw bytes" );
+        writer.write( &value, sizeof( T ) );
+    }
+    else
+    {
+        std::ostringstream out;
+        out << value;
+        const std::string string = out.str( );
+        writer.write_string( string.data( ), string.size( ) );
+    }
+}
+
+template < class T >
+void
+print( std::ostream& out, Reader& reader )
+{
+    if constexpr( std::is_array< T >::value || IS_STRING< T > || !IS_RAW< T > )
+    {
+        reader.print_string( out );
+    }
+    else
+    {
+        alignas( T ) unsigned char storage[ sizeof( T ) ];
+        reader.read( storage, sizeof( T ) );
+        out << *std::launder( reinterpret_cast< const T* >( storage ) );
+    }
+}
+
+template < class... Args >
+void
+decode( std::ostream* out, const unsigned char* payload )
+{
+    if( nullptr != out )
+    {
+        Reader reader{ payload };
+        ( print< Args >( *out, reader ), ... );
+    }
+}
+
+/// Arguments that do not fit the record are formatted by the caller, the record owns the text
+inline void
+decode_text( std::ostream* out, const unsigned char* payload )
+{
+    std::string* text{ nullptr };
+    std::memcpy( &text, payload, sizeof( text ) );
+    if( nullptr != out )
+    {
+        *out << *text;
+    }
+    delete text;
+}
+
+/// Keeps the per-thread order for any size of the arguments
+template < class... Args >
+void
+encode_record( BinaryLogRecord& record, const Args&... args )
+{
+    record.decoder = &decode< Args... >;
+    Writer writer{ record };
+    ( encode( writer, args ), ... );
+    if( !writer.finish( ) )
+    {
+        std::ostringstream out;
+        ( out << ... << args );
+        auto* text = new std::string( out.str( ) );
+        std::memcpy( record.payload, &text, sizeof( text ) );
+        record.size = sizeof( text );
+        record.decoder = &decode_text;
+    }
+}
+
+}  // namespace binary_log
+}  // namespace common
+}  // namespace uni
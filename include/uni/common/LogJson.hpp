@@ -0,0 +1,337 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/LogJson.hpp
+/// @brief Declaration JSON writer of LOG_CLASS.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace uni
+{
+namespace common
+{
+/*
+ * Writes JSON into the caller's buffer, never allocates.
+ * When the buffer is too small the writing goes on without copying, size( ) is the size the full text needs then.
+ */
+class JsonWriter
+{
+public:
+    JsonWriter( char* buffer, size_t capacity ) noexcept
+        : m_buffer{ buffer }
+        , m_capacity{ capacity }
+    {
+    }
+
+    void
+    write_raw( const char* data, size_t size ) noexcept
+    {
+        if( !m_is_overflow && ( size <= m_capacity - m_size ) )
+        {
+            std::memcpy( m_buffer + m_size, data, size );
+        }
+        else
+        {
+            m_is_overflow = true;
+        }
+        m_size += size;
+    }
+
+    void
+    write_char( char ch ) noexcept
+    {
+        write_raw( &ch, 1U );
+    }
+
+    /// Key of LOG_IT, the identifier does not need escaping and its length is known at compile time
+    template < size_t N >
+    void
+    write_key( const char ( &key )[ N ] ) noexcept
+    {
+        write_char( '"' );
+        write_raw( key, N - 1U );
+        write_raw( "\":", 2U );
+    }
+
+    void
+    write_string( const char* data, size_t size ) noexcept
+    {
+        write_char( '"' );
+        write_string_part( data, size );
+        write_char( '"' );
+    }
+
+    /// Escaped text of the string without the quotes, so the string can be written in parts
+    void
+    write_string_part( const char* data, size_t size ) noexcept
+    {
+        size_t begin{ 0U };
+        for( size_t i = 0U; i < size; ++i )
+        {
+            const auto ch = static_cast< unsigned char >( data[ i ] );
+            if( ( ch >= 0x20U ) && ( '"' != ch ) && ( '\\' != ch ) )
+            {
+                continue;
+            }
+
+            write_raw( data + begin, i - begin );
+            begin = i + 1U;
+            write_escaped( ch );
+        }
+        write_raw( data + begin, size - begin );
+    }
+
+    template < class T >
+    void
+    write_number( T value ) noexcept
+    {
+        if constexpr( std::is_floating_point< T >::value )
+        {
+            if( !std::isfinite( value ) )
+            {
+                write_raw( "null", 4U );  // JSON has no NaN and infinity
+                return;
+            }
+        }
+
+        char digits[ 32 ];
+        const auto result = std::to_chars( digits, digits + sizeof( digits ), value );
+        write_raw( digits, static_cast< size_t >( result.ptr - digits ) );
+    }
+
+    /// Size of the full text, larger than the capacity if is_overflow( )
+    size_t
+    size( ) const noexcept
+    {
+        return m_size;
+    }
+
+    bool
+    is_overflow( ) const noexcept
+    {
+        return m_is_overflow;
+    }
+
+private:
+    void
+    write_escaped( unsigned char ch ) noexcept
+    {
+        switch( ch )
+        {
+            case '"':
+                write_raw( "\\\"", 2U );
+                break;
+            case '\\':
+                write_raw( "\\\\", 2U );
+                break;
+            case '\n':
+                write_raw( "\\n", 2U );
+                break;
+            case '\r':
+                write_raw( "\\r", 2U );
+                break;
+            case '\t':
+                write_raw( "\\t", 2U );
+                break;
+            default:
+            {
+                static constexpr char HEX[]{ "0123456789abcdef" };
+                const char escaped[]{ '\\', 'u', '0', '0', HEX[ ch >> 4U ], HEX[ ch & 0xFU ] };
+                write_raw( escaped, sizeof( escaped ) );
+            }
+            break;
+        }
+    }
+
+    char* const m_buffer{ nullptr };
+    const size_t m_capacity{ 0U };
+    size_t m_size{ 0U };
+    bool m_is_overflow{ false };
+};
+
+/// Passes operator<< of the types without serialize_json( ) to the writer as the parts of one JSON string
+class JsonStreamBuffer : public std::streambuf
+{
+public:
+    explicit JsonStreamBuffer( JsonWriter& writer ) noexcept
+        : m_writer{ writer }
+    {
+    }
+
+protected:
+    int_type
+    overflow( int_type ch ) override
+    {
+        if( !traits_type::eq_int_type( ch, traits_type::eof( ) ) )
+        {
+            const char data = traits_type::to_char_type( ch );
+            m_writer.write_string_part( &data, 1U );
+        }
+        return traits_type::not_eof( ch );
+    }
+
+    std::streamsize
+    xsputn( const char* data, std::streamsize size ) override
+    {
+        m_writer.write_string_part( data, static_cast< size_t >( size ) );
+        return size;
+    }
+
+private:
+    JsonWriter& m_writer;
+};
+
+namespace json
+{
+template < class T, class = void >
+constexpr bool HAS_SERIALIZE_JSON = false;
+
+template < class T >
+constexpr bool HAS_SERIALIZE_JSON< T, std::void_t< decltype( std::declval< const T& >( ).serialize_json( std::declval< JsonWriter& >( ) ) ) > > = true;
+
+/// enum_name( ) is generated by LOG_ENUM
+template < class T, class = void >
+constexpr bool HAS_ENUM_NAME = false;
+
+template < class T >
+constexpr bool HAS_ENUM_NAME< T, std::void_t< decltype( enum_name( std::declval< T >( ) ) ) > > = true;
+
+template < class T, class = void >
+constexpr bool IS_RANGE = false;
+
+template < class T >
+constexpr bool IS_RANGE< T, std::void_t< decltype( std::begin( std::declval< const T& >( ) ) ), decltype( std::end( std::declval< const T& >( ) ) ) > > = true;
+
+template < class T >
+constexpr bool IS_STRING = std::is_convertible< const T&, std::string_view >::value;
+
+}  // namespace json
+
+/// Types can add serialize_json( JsonWriter& ) const, LOG_CLASS does it
+template < class T >
+void
+write_json( JsonWriter& writer, const T& value )
+{
+    if constexpr( json::HAS_SERIALIZE_JSON< T > )
+    {
+        value.serialize_json( writer );
+    }
+    else if constexpr( std::is_same< T, bool >::value )
+    {
+        value ? writer.write_raw( "true", 4U ) : writer.write_raw( "false", 5U );
+    }
+    else if constexpr( std::is_same< T, char >::value )
+    {
+        writer.write_string( &value, 1U );
+    }
+    else if constexpr( std::is_arithmetic< T >::value )
+    {
+        writer.write_number( value );
+    }
+    else if constexpr( std::is_enum< T >::value )
+    {
+        if constexpr( json::HAS_ENUM_NAME< T > )
+        {
+            const char* name = enum_name( value );
+            ( nullptr != name ) ? writer.write_string( name, std::strlen( name ) ) : writer.write_raw( "\"UNKNOWN\"", 9U );
+        }
+        else
+        {
+            writer.write_number( static_cast< std::underlying_type_t< T > >( value ) );
+        }
+    }
+    else if constexpr( json::IS_STRING< T > )
+    {
+        if constexpr( std::is_pointer< T >::value )
+        {
+            if( nullptr == value )
+            {
+                writer.write_raw( "null", 4U );
+                return;
+            }
+        }
+
+        const std::string_view string{ value };
+        writer.write_string( string.data( ), string.size( ) );
+    }
+    else if constexpr( std::is_pointer< T >::value )
+    {
+        ( nullptr == value ) ? writer.write_raw( "null", 4U ) : write_json( writer, *value );
+    }
+    else if constexpr( json::IS_RANGE< T > )
+    {
+        writer.write_char( '[' );
+        bool is_first{ true };
+        for( const auto& item : value )
+        {
+            if( !is_first )
+            {
+                writer.write_char( ',' );
+            }
+            is_first = false;
+            write_json( writer, item );
+        }
+        writer.write_char( ']' );
+    }
+    else
+    {
+        JsonStreamBuffer buffer{ writer };
+        std::ostream out{ &buffer };
+        writer.write_char( '"' );
+        out << value;
+        writer.write_char( '"' );
+    }
+}
+
+template < size_t N, class T >
+void
+write_json_fields( JsonWriter& writer, const char ( &key )[ N ], const T& value )
+{
+    writer.write_key( key );
+    write_json( writer, value );
+}
+
+template < size_t N, class T, class... Args >
+void
+write_json_fields( JsonWriter& writer, const char ( &key )[ N ], const T& value, const Args&... args )
+{
+    write_json_fields( writer, key, value );
+    writer.write_char( ',' );
+    write_json_fields( writer, args... );
+}
+
+/// Serializes into the stack buffer, only a larger text takes the heap
+template < class T >
+void
+print_json( std::ostream& out, const T& value )
+{
+    char buffer[ 1024 ];
+    JsonWriter writer{ buffer, sizeof( buffer ) };
+    write_json( writer, value );
+    if( !writer.is_overflow( ) )
+    {
+        out.write( buffer, static_cast< std::streamsize >( writer.size( ) ) );
+        return;
+    }
+
+    std::string text( writer.size( ), '\0' );
+    JsonWriter text_writer{ text.data( ), text.size( ) };
+    write_json( text_writer, value );
+    out.write( text.data( ), static_cast< std::streamsize >( text.size( ) ) );
+}
+
+}  // namespace common
+}  // namespace uni
@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/LogLimiter.hpp
+/// @brief Declaration per-callsite log limiters.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace uni
+{
+namespace common
+{
+/*
+ * State of one LOG_EVERY_N, LOG_FIRST_N, LOG_EVERY_MS or LOG_RATE_LIMITED call site, kept in the function-local static.
+ * The constructors are constexpr, so with the constant arguments the static is constant initialized and has no guard.
+ * allow( ) is lock-free. suppressed_count is the number of the calls dropped since the previous allowed one,
+ * the macros append it to the allowed record.
+ */
+class LogEveryN
+{
+public:
+    constexpr explicit LogEveryN( uint64_t n ) noexcept
+        : m_n{ ( 0U == n ) ? 1U : n }
+    {
+    }
+
+    bool
+    allow( uint64_t& suppressed_count ) noexcept
+    {
+        suppressed_count = 0U;  // Always n - 1, not worth printing
+        return 0U == ( m_count.fetch_add( 1U, std::memory_order_relaxed ) % m_n );
+    }
+
+private:
+    const uint64_t m_n{ 1U };
+    std::atomic< uint64_t > m_count{ 0U };
+};
+
+class LogFirstN
+{
+public:
+    constexpr explicit LogFirstN( uint64_t n ) noexcept
+        : m_n{ n }
+    {
+    }
+
+    bool
+    allow( uint64_t& suppressed_count ) noexcept
+    {
+        suppressed_count = 0U;
+
+        // Once the limit is reached the calls only read the shared line
+        if( m_count.load( std::memory_order_relaxed ) >= m_n )
+        {
+            return false;
+        }
+        return m_count.fetch_add( 1U, std::memory_order_relaxed ) < m_n;
+    }
+
+private:
+    const uint64_t m_n{ 0U };
+    std::atomic< uint64_t > m_count{ 0U };
+};
+
+class LogEveryMs
+{
+public:
+    constexpr explicit LogEveryMs( uint64_t period_ms ) noexcept
+        : m_period_ns{ static_cast< int64_t >( period_ms * 1000000U ) }
+    {
+    }
+
+    bool
+    allow( uint64_t& suppressed_count ) noexcept
+    {
+        const int64_t now = now_ns( );
+        int64_t next = m_next_ns.load( std::memory_order_relaxed );
+        if( ( now < next ) || !m_next_ns.compare_exchange_strong( next, now + m_period_ns, std::memory_order_relaxed ) )
+        {
+            m_suppressed_count.fetch_add( 1U, std::memory_order_relaxed );
+            return false;
+        }
+        suppressed_count = m_suppressed_count.exchange( 0U, std::memory_order_relaxed );
+        return true;
+    }
+
+private:
+    static int64_t
+    now_ns( ) noexcept
+    {
+        return std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now( ).time_since_epoch( ) ).count( );
+    }
+
+    const int64_t m_period_ns{ 0 };
+    std::atomic< int64_t > m_next_ns{ INT64_MIN };
+    std::atomic< uint64_t > m_suppressed_count{ 0U };
+};
+
+/*
+ * Token bucket of burst tokens refilled at per_second, kept as the single timestamp (generic cell rate algorithm):
+ * the theoretical arrival time moves forward by one interval per allowed call and may run ahead of now by burst intervals.
+ */
+class LogTokenBucket
+{
+public:
+    constexpr LogTokenBucket( uint64_t per_second, uint64_t burst ) noexcept
+        : m_interval_ns{ static_cast< int64_t >( 1000000000U / ( ( 0U == per_second ) ? 1U : per_second ) ) }
+        , m_tolerance_ns{ m_interval_ns * static_cast< int64_t >( ( 0U == burst ) ? 1U : burst ) }
+    {
+    }
+
+    bool
+    allow( uint64_t& suppressed_count ) noexcept
+    {
+        const int64_t now = now_ns( );
+        int64_t arrival = m_arrival_ns.load( std::memory_order_relaxed );
+        while( true )
+        {
+            const int64_t next = ( ( arrival > now ) ? arrival : now ) + m_interval_ns;
+            if( next - now > m_tolerance_ns )
+            {
+                m_suppressed_count.fetch_add( 1U, std::memory_order_relaxed );
+                return false;
+            }
+            if( m_arrival_ns.compare_exchange_weak( arrival, next, std::memory_order_relaxed ) )
+            {
+                break;
+            }
+        }
+        suppressed_count = m_suppressed_count.exchange( 0U, std::memory_order_relaxed );
+        return true;
+    }
+
+private:
+    static int64_t
+    now_ns( ) noexcept
+    {
+        return std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now( ).time_since_epoch( ) ).count( );
+    }
+
+    const int64_t m_interval_ns{ 0 };
+    const int64_t m_tolerance_ns{ 0 };
+    std::atomic< int64_t > m_arrival_ns{ 0 };
+    std::atomic< uint64_t > m_suppressed_count{ 0U };
+};
+
+}  // namespace common
+}  // namespace uni
@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/LogSink.hpp
+/// @brief Declaration log sinks.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "uni/common/Defines.hpp"
+#include "uni/common/ErrorCode.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace uni
+{
+namespace common
+{
+/*
+ * Destination of the formatted records.
+ * The logger calls write( ) and flush( ) under its stream lock, a sink is never used by two threads at once.
+ * A sink must not log itself: the stream lock is held.
+ */
+class UNI_API LogSink
+{
+public:
+    virtual ~LogSink( ) = default;
+
+    /// One or more complete lines
+    virtual void write( const char* data, size_t size ) = 0;
+
+    virtual void flush( ) = 0;
+};
+
+/// Default sink of the logger, std::cout
+class UNI_API OstreamLogSink : public LogSink
+{
+public:
+    explicit OstreamLogSink( std::ostream& ostream )
+        : m_ostream{ ostream }
+    {
+    }
+
+    void
+    write( const char* data, size_t size ) override
+    {
+        m_ostream.write( data, static_cast< std::streamsize >( size ) );
+    }
+
+    void
+    flush( ) override
+    {
+        m_ostream.flush( );
+    }
+
+private:
+    std::ostream& m_ostream;
+};
+
+/// Drops everything, measures the cost of the logging itself
+class UNI_API NullLogSink : public LogSink
+{
+public:
+    void
+    write( const char*, size_t ) override
+    {
+    }
+
+    void
+    flush( ) override
+    {
+    }
+};
+
+/*
+ * Copies the records into the pre-sized memory-mapped file, no system call per write.
+ * The kernel writes the dirty pages back on its own, flush( ) only schedules the write-back.
+ * The file is rotated when it is full or rotate_interval_ms passed since it was opened:
+ * it is truncated to the written size and renamed to path.1, path.1 to path.2 and so on up to path.<max_file_count - 1>.
+ * If the next file can not be opened the records are dropped and the opening is retried by the writes, at most every retry_interval_ms.
+ * Not supported on Windows, open( ) fails there.
+ */
+class UNI_API MappedFileLogSink : public LogSink
+{
+public:
+    struct Settings
+    {
+        std::string path{};
+        size_t file_size{ 64U * 1024U * 1024U };  //< Mapped and reserved on open, rotated when full
+        uint64_t rotate_interval_ms{ 0U };          //< 0 - rotated by size only
+        size_t max_file_count{ 8U };                //< The current file and the rotated ones
+        uint64_t retry_interval_ms{ 1000U };        //< Between the attempts to open the file after a failed rotation
+    };
+
+public:
+    explicit MappedFileLogSink( const Settings& settings );
+    ~MappedFileLogSink( ) override;
+
+    MappedFileLogSink( const MappedFileLogSink& ) = delete;
+    MappedFileLogSink& operator=( const MappedFileLogSink& ) = delete;
+
+    /// INVALID_PARAM for the empty path or the zero size, INTERNAL if the file can not be created or mapped
+    ErrorCode open( );
+
+    void write( const char* data, size_t size ) override;
+
+    void flush( ) override;
+
+    /// Bytes lost because the next file could not be opened
+    uint64_t get_dropped_size( ) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /// After a failure the next attempt is not earlier than retry_interval_ms
+    ErrorCode map_file( );
+    void unmap_file( );
+    void rotate( );
+
+    const Settings m_settings{};
+    bool m_is_open{ false };  //< open( ) succeeded, a failed rotation is retried
+    int m_file{ -1 };
+    char* m_data{ nullptr };
+    size_t m_offset{ 0U };
+    Clock::time_point m_rotate_time{};
+    Clock::time_point m_retry_time{};  //< Earliest next attempt to open the file while it is not mapped
+    std::atomic< uint64_t > m_dropped_size{ 0U };
+};
+
+}  // namespace common
+}  // namespace uni
@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/Metrics.hpp
+/// @brief Declaration latency histogram and metrics helpers.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "uni/common/Defines.hpp"
+#include "uni/common/Log.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+namespace uni
+{
+namespace common
+{
+/// Printable digest of the latency distribution
+struct LatencySummary
+{
+    uint64_t count{ 0U };
+    uint64_t mean_ns{ 0U };
+    uint64_t p50_ns{ 0U };
+    uint64_t p90_ns{ 0U };
+    uint64_t p99_ns{ 0U };
+    uint64_t max_ns{ 0U };
+
+    LOG_CLASS( LatencySummary, LOG_IT( count ), LOG_IT( mean_ns ), LOG_IT( p50_ns ), LOG_IT( p90_ns ), LOG_IT( p99_ns ), LOG_IT( max_ns ) );
+};
+
+/*
+ * Log-linear buckets: 4 buckets per power of two, so a percentile is off by 25% at most.
+ * Values below 4 ns have exact buckets.
+ */
+class UNI_API HistogramSnapshot
+{
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS{ 2U };
+    static constexpr uint32_t SUB_BUCKET_COUNT{ 1U << SUB_BUCKET_BITS };
+    static constexpr uint32_t BUCKET_COUNT{ ( 64U - SUB_BUCKET_BITS + 1U ) * SUB_BUCKET_COUNT };
+
+public:
+    static uint32_t get_bucket_index( uint64_t value ) noexcept;
+    static uint64_t get_bucket_upper_bound( uint32_t index ) noexcept;
+
+    void merge( const HistogramSnapshot& other );
+
+    uint64_t get_count( ) const noexcept;
+    uint64_t get_max( ) const noexcept;
+    uint64_t get_mean( ) const noexcept;
+
+    /// Upper bound of the bucket holding the quantile, quantile is in [0, 1]
+    uint64_t get_percentile( double quantile ) const noexcept;
+
+    LatencySummary summarize( ) const;
+
+    void
+    serialize_json( JsonWriter& writer ) const
+    {
+        summarize( ).serialize_json( writer );
+    }
+
+    friend std::ostream&
+    operator<<( std::ostream& out, const HistogramSnapshot& snapshot )
+    {
+        return out << snapshot.summarize( );
+    }
+
+private:
+    friend class LatencyHistogram;
+
+    std::array< uint64_t, BUCKET_COUNT > m_buckets{};
+    uint64_t m_count{ 0U };
+    uint64_t m_sum{ 0U };
+    uint64_t m_max{ 0U };
+};
+
+/*
+ * Latency histogram with the single writer. record( ) is a few relaxed loads and stores,
+ * snapshot( ) may run on any thread concurrently with the writer and sees a slightly stale state.
+ */
+class UNI_API LatencyHistogram
+{
+public:
+    void
+    record( uint64_t value_ns ) noexcept
+    {
+        increment( m_buckets[ HistogramSnapshot::get_bucket_index( value_ns ) ], 1U );
+        increment( m_count, 1U );
+        increment( m_sum, value_ns );
+        if( value_ns > m_max.load( std::memory_order_relaxed ) )
+        {
+            m_max.store( value_ns, std::memory_order_relaxed );
+        }
+    }
+
+    HistogramSnapshot snapshot( ) const;
+
+private:
+    static void
+    increment( std::atomic< uint64_t >& counter, uint64_t value ) noexcept
+    {
+        // Only the owner writes, no need in the locked increment
+        counter.store( counter.load( std::memory_order_relaxed ) + value, std::memory_order_relaxed );
+    }
+
+private:
+    std::array< std::atomic< uint64_t >, HistogramSnapshot::BUCKET_COUNT > m_buckets{};
+    std::atomic< uint64_t > m_count{ 0U };
+    std::atomic< uint64_t > m_sum{ 0U };
+    std::atomic< uint64_t > m_max{ 0U };
+};
+
+}  // namespace common
+}  // namespace uni
@@ -0,0 +1,353 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/MpmcQueue.hpp
+/// @brief Declaration lock-free bounded multi-producer multi-consumer queue.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+/// @note Thanks to the "Bounded MPMC queue" by Dmitry Vyukov
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "uni/common/Backoff.hpp"
+#include "uni/common/Constants.hpp"
+#include "uni/common/Defines.hpp"
+#include "uni/common/Queue.hpp"
+#include "uni/common/QueueSignal.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace uni
+{
+namespace common
+{
+/*
+ * Ring buffer of the power-of-two size, every cell carries a sequence number:
+ * cell is free for the producer at position pos when sequence == pos, and ready for the consumer when sequence == pos + 1.
+ * Producers and consumers only contend on their own position counter, one CAS per operation.
+ * Blocking calls spin first and sleep on the condition variable only when there is nothing to do,
+ * the opposite side takes the mutex only if somebody is actually sleeping.
+ * Has the same push/try_pop/wait_pop/close contract as Queue.
+ */
+template < class T >
+class UNI_API MpmcQueue
+{
+    using DataType = T;
+
+public:
+    static constexpr size_t DEFAULT_CAPACITY{ 1024U };
+
+public:
+    explicit MpmcQueue( size_t capacity = DEFAULT_CAPACITY )
+        : m_mask{ round_up_to_power_of_two( capacity ) - 1U }
+        , m_cells{ std::make_unique< Cell[] >( m_mask + 1U ) }
+    {
+        for( size_t i = 0U; i <= m_mask; ++i )
+        {
+            m_cells[ i ].sequence.store( i, std::memory_order_relaxed );
+        }
+    }
+
+    MpmcQueue( const MpmcQueue& ) = delete;
+    MpmcQueue& operator=( const MpmcQueue& ) = delete;
+
+    /// No other thread uses the queue any more, every cell between the positions holds an element
+    ~MpmcQueue( )
+    {
+        const size_t enqueue_position = m_enqueue_position.load( std::memory_order_acquire );
+        for( size_t position = m_dequeue_position.load( std::memory_order_acquire ); position != enqueue_position; ++position )
+        {
+            m_cells[ position & m_mask ].data( )->~T( );
+        }
+    }
+
+    /// Blocks while the queue is full. CLOSED if the queue is closed, the element is dropped then
+    OperationStatus
+    push( const T& data )
+    {
+        T copy{ data };
+        return push( std::move( copy ) );
+    }
+
+    OperationStatus
+    push( T&& data )
+    {
+        Backoff backoff{ SPIN_COUNT, YIELD_COUNT };
+        OperationStatus status{ OperationStatus::UNSUCCESS };
+        while( OperationStatus::UNSUCCESS == ( status = try_push( std::move( data ) ) ) )
+        {
+            if( !backoff.pause( ) )
+            {
+                wait_not_full( );
+                backoff.reset( );
+            }
+        }
+        return status;
+    }
+
+    /// UNSUCCESS when the queue is full, data is not moved from then
+    OperationStatus
+    try_push( T&& data )
+    {
+        if( m_is_closed.load( std::memory_order_acquire ) )
+        {
+            return OperationStatus::CLOSED;
+        }
+
+        if( !enqueue( std::move( data ) ) )
+        {
+            return OperationStatus::UNSUCCESS;
+        }
+
+        notify( m_waiting_consumers, m_not_empty_cv );
+        notify_signal( );
+        return OperationStatus::SUCCESS;
+    }
+
+    OperationStatus
+    wait_pop( T& element )
+    {
+        Backoff backoff{ SPIN_COUNT, YIELD_COUNT };
+        while( true )
+        {
+            const OperationStatus status = try_pop( element );
+            if( OperationStatus::UNSUCCESS != status )
+            {
+                return status;
+            }
+
+            if( m_is_closed.load( std::memory_order_acquire ) )
+            {
+                // The last elements might be pushed right before the close
+                return ( OperationStatus::SUCCESS == try_pop( element ) ) ? OperationStatus::SUCCESS : OperationStatus::CLOSED;
+            }
+
+            if( !backoff.pause( ) )
+            {
+                wait_not_empty( );
+                backoff.reset( );
+            }
+        }
+    }
+
+    OperationStatus
+    try_pop( T& value )
+    {
+        if( !dequeue( value ) )
+        {
+            return OperationStatus::UNSUCCESS;
+        }
+
+        notify( m_waiting_producers, m_not_full_cv );
+        return OperationStatus::SUCCESS;
+    }
+
+    /// Elements already in the queue can still be popped
+    void
+    close( )
+    {
+        m_is_closed.store( true, std::memory_order_seq_cst );
+
+        std::lock_guard< std::mutex > lock( m_mutex );
+        m_not_empty_cv.notify_all( );
+        m_not_full_cv.notify_all( );
+        notify_signal( );
+    }
+
+    /// Signal notified on every push and on close, used by QueueSet. nullptr detaches
+    void
+    set_signal( QueueSignal* signal ) noexcept
+    {
+        m_signal.store( signal, std::memory_order_release );
+    }
+
+    bool
+    closed( ) const
+    {
+        return m_is_closed.load( std::memory_order_acquire );
+    }
+
+    /// Approximate while the queue is in use
+    bool
+    empty( ) const
+    {
+        return 0U == size( );
+    }
+
+    /// Approximate while the queue is in use
+    size_t
+    size( ) const
+    {
+        const size_t dequeue_position = m_dequeue_position.load( std::memory_order_acquire );
+        const size_t enqueue_position = m_enqueue_position.load( std::memory_order_acquire );
+        return ( enqueue_position > dequeue_position ) ? enqueue_position - dequeue_position : 0U;
+    }
+
+    size_t
+    capacity( ) const noexcept
+    {
+        return m_mask + 1U;
+    }
+
+private:
+    static constexpr uint32_t SPIN_COUNT{ 16U };
+    static constexpr uint32_t YIELD_COUNT{ 4U };
+
+    struct Cell
+    {
+        std::atomic< size_t > sequence{ 0U };
+        alignas( T ) unsigned char storage[ sizeof( T ) ];
+
+        T*
+        data( ) noexcept
+        {
+            return std::launder( reinterpret_cast< T* >( storage ) );
+        }
+    };
+
+    static size_t
+    round_up_to_power_of_two( size_t value ) noexcept
+    {
+        size_t result{ 2U };
+        while( result < value )
+        {
+            result <<= 1U;
+        }
+        return result;
+    }
+
+    bool
+    enqueue( T&& data )
+    {
+        Cell* cell{ nullptr };
+        size_t position = m_enqueue_position.load( std::memory_order_relaxed );
+        while( true )
+        {
+            cell = &m_cells[ position & m_mask ];
+            const size_t sequence = cell->sequence.load( std::memory_order_acquire );
+            const auto difference = static_cast< std::intptr_t >( sequence ) - static_cast< std::intptr_t >( position );
+            if( 0 == difference )
+            {
+                if( m_enqueue_position.compare_exchange_weak( position, position + 1U, std::memory_order_relaxed ) )
+                {
+                    break;
+                }
+            }
+            else if( difference < 0 )
+            {
+                return false;  // Full
+            }
+            else
+            {
+                position = m_enqueue_position.load( std::memory_order_relaxed );
+            }
+        }
+
+        ::new( static_cast< void* >( cell->storage ) ) T( std::move( data ) );
+        cell->sequence.store( position + 1U, std::memory_order_release );
+        return true;
+    }
+
+    bool
+    dequeue( T& value )
+    {
+        Cell* cell{ nullptr };
+        size_t position = m_dequeue_position.load( std::memory_order_relaxed );
+        while( true )
+        {
+            cell = &m_cells[ position & m_mask ];
+            const size_t sequence = cell->sequence.load( std::memory_order_acquire );
+            const auto difference = static_cast< std::intptr_t >( sequence ) - static_cast< std::intptr_t >( position + 1U );
+            if( 0 == difference )
+            {
+                if( m_dequeue_position.compare_exchange_weak( position, position + 1U, std::memory_order_relaxed ) )
+                {
+                    break;
+                }
+            }
+            else if( difference < 0 )
+            {
+                return false;  // Empty
+            }
+            else
+            {
+                position = m_dequeue_position.load( std::memory_order_relaxed );
+            }
+        }
+
+        T* element = cell->data( );
+        value = std::move( *element );
+        element->~T( );
+        cell->sequence.store( position + m_mask + 1U, std::memory_order_release );
+        return true;
+    }
+
+    void
+    notify_signal( )
+    {
+        if( QueueSignal* signal = m_signal.load( std::memory_order_acquire ) )
+        {
+            signal->notify( );
+        }
+    }
+
+    void
+    notify( const std::atomic< uint32_t >& waiting_count, std::condition_variable& cv )
+    {
+        // Pairs with the fence in wait( ): either the sleeper sees the change or we see the sleeper
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        if( waiting_count.load( std::memory_order_relaxed ) > 0U )
+        {
+            std::lock_guard< std::mutex > lock( m_mutex );
+            cv.notify_one( );
+        }
+    }
+
+    template < class Predicate >
+    void
+    wait( std::atomic< uint32_t >& waiting_count, std::condition_variable& cv, Predicate&& is_ready )
+    {
+        std::unique_lock< std::mutex > lock( m_mutex );
+        waiting_count.fetch_add( 1U, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        cv.wait( lock, [ this, &is_ready ] { return is_ready( ) || m_is_closed.load( std::memory_order_acquire ); } );
+        waiting_count.fetch_sub( 1U, std::memory_order_relaxed );
+    }
+
+    void
+    wait_not_empty( )
+    {
+        wait( m_waiting_consumers, m_not_empty_cv, [ this ] { return !empty( ); } );
+    }
+
+    void
+    wait_not_full( )
+    {
+        wait( m_waiting_producers, m_not_full_cv, [ this ] { return size( ) < capacity( ); } );
+    }
+
+private:
+    const size_t m_mask{ 0U };
+    const std::unique_ptr< Cell[] > m_cells{};
+
+    alignas( CACHE_LINE_SIZE ) std::atomic< size_t > m_enqueue_position{ 0U };
+    alignas( CACHE_LINE_SIZE ) std::atomic< size_t > m_dequeue_position{ 0U };
+
+    // Sleeping side, touched only when a blocking call runs out of spinning
+    alignas( CACHE_LINE_SIZE ) std::atomic< bool > m_is_closed{ false };
+    std::atomic< uint32_t > m_waiting_consumers{ 0U };
+    std::atomic< uint32_t > m_waiting_producers{ 0U };
+    std::mutex m_mutex{};
+    std::condition_variable m_not_empty_cv{};
+    std::condition_variable m_not_full_cv{};
+    std::atomic< QueueSignal* > m_signal{ nullptr };
+};
+
+}  // namespace common
+}  // namespace uni
@@ -0,0 +1,195 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/PriorityQueue.hpp
+/// @brief Declaration d-ary heap container and thread safe priority queue.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "uni/common/Defines.hpp"
+#include "uni/common/Queue.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace uni
+{
+namespace common
+{
+/*
+ * Heap with ARITY children per node in the contiguous vector: the tree is ARITY times shallower than
+ * the binary one and the children of a node share a cache line or two.
+ * Order follows std::priority_queue: the greatest element by Compare goes first.
+ * Equal elements go in the push order.
+ * Has the container interface of Queue, front( ) is the top element.
+ */
+template < class T, class Compare = std::less< T >, size_t ARITY = 4U >
+class UNI_API DaryHeap
+{
+    static_assert( ARITY >= 2U, "Heap needs at least two children per node" );
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+public:
+    explicit DaryHeap( const Compare& compare = Compare( ) )
+        : m_compare{ compare }
+    {
+    }
+
+    void
+    push_back( const T& value )
+    {
+        emplace_back( value );
+    }
+
+    void
+    push_back( T&& value )
+    {
+        emplace_back( std::move( value ) );
+    }
+
+    template < class... Args >
+    void
+    emplace_back( Args&&... args )
+    {
+        m_nodes.push_back( Node{ T( std::forward< Args >( args )... ), m_next_sequence++ } );
+        sift_up( m_nodes.size( ) - 1U );
+    }
+
+    /// The container must not be empty
+    T&
+    front( ) noexcept
+    {
+        return m_nodes.front( ).value;
+    }
+
+    const T&
+    front( ) const noexcept
+    {
+        return m_nodes.front( ).value;
+    }
+
+    /// The container must not be empty
+    void
+    pop_front( )
+    {
+        if( m_nodes.size( ) > 1U )
+        {
+            m_nodes.front( ) = std::move( m_nodes.back( ) );
+            m_nodes.pop_back( );
+            sift_down( 0U );
+        }
+        else
+        {
+            m_nodes.pop_back( );
+        }
+    }
+
+    bool
+    empty( ) const noexcept
+    {
+        return m_nodes.empty( );
+    }
+
+    size_t
+    size( ) const noexcept
+    {
+        return m_nodes.size( );
+    }
+
+    void
+    reserve( size_t capacity )
+    {
+        m_nodes.reserve( capacity );
+    }
+
+private:
+    struct Node
+    {
+        T value;
+        uint64_t sequence;  //< Tie breaker, the earlier push goes first
+    };
+
+    /// True if lhs has to be popped before rhs
+    bool
+    is_before( const Node& lhs, const Node& rhs ) const
+    {
+        if( m_compare( rhs.value, lhs.value ) )
+        {
+            return true;
+        }
+        return !m_compare( lhs.value, rhs.value ) && ( lhs.sequence < rhs.sequence );
+    }
+
+    void
+    sift_up( size_t index )
+    {
+        Node node{ std::move( m_nodes[ index ] ) };
+        while( index > 0U )
+        {
+            const size_t parent = ( index - 1U ) / ARITY;
+            if( !is_before( node, m_nodes[ parent ] ) )
+            {
+                break;
+            }
+            m_nodes[ index ] = std::move( m_nodes[ parent ] );
+            index = parent;
+        }
+        m_nodes[ index ] = std::move( node );
+    }
+
+    void
+    sift_down( size_t index )
+    {
+        const size_t size = m_nodes.size( );
+        Node node{ std::move( m_nodes[ index ] ) };
+        while( true )
+        {
+            const size_t first_child = index * ARITY + 1U;
+            if( first_child >= size )
+            {
+                break;
+            }
+
+            size_t best = first_child;
+            const size_t last_child = std::min( first_child + ARITY, size );
+            for( size_t child = first_child + 1U; child < last_child; ++child )
+            {
+                if( is_before( m_nodes[ child ], m_nodes[ best ] ) )
+                {
+                    best = child;
+                }
+            }
+
+            if( !is_before( m_nodes[ best ], node ) )
+            {
+                break;
+            }
+            m_nodes[ index ] = std::move( m_nodes[ best ] );
+            index = best;
+        }
+        m_nodes[ index ] = std::move( node );
+    }
+
+private:
+    Compare m_compare{ };
+    std::vector< Node > m_nodes{ };
+    uint64_t m_next_sequence{ 0U };
+};
+
+/// Queue popping the greatest element first, same blocking, capacity, bulk and close semantics.
+/// pop_bulk( out, n ) drains the top n elements in order
+template < class T, class Compare = std::less< T >, size_t ARITY = 4U >
+using PriorityQueue = Queue< T, DaryHeap< T, Compare, ARITY > >;
+
+}  // namespace common
+}  // namespace uni
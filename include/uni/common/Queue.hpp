@@ -8,11 +8,19 @@
 
 #pragma once
 
+#include "uni/common/Backoff.hpp"
 #include "uni/common/Defines.hpp"
+#include "uni/common/Log.hpp"
+#include "uni/common/QueueSignal.hpp"
+#include "uni/common/RingBuffer.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
-#include <queue>
+#include <utility>
 
 namespace uni
 {
@@ -26,69 +34,235 @@ enum class OperationStatus
     CLOSED
 };
 
-template < class T, typename Container = std::deque< T > >
+/// Counters of the queue, collected after Queue::set_metrics_enabled( true )
+struct QueueMetrics
+{
+    uint64_t push_count{ 0U };
+    uint64_t pop_count{ 0U };
+    uint64_t size{ 0U };
+    uint64_t max_size{ 0U };  //< High watermark
+
+    LOG_CLASS( QueueMetrics, LOG_IT( push_count ), LOG_IT( pop_count ), LOG_IT( size ), LOG_IT( max_size ) );
+};
+
+/// FIFO. Container needs push_back( ), front( ), pop_front( ), empty( ) and size( )
+template < class T, typename Container = RingBuffer< T > >
 class UNI_API Queue
 {
     using DataType = T;
 
+public:
+    static constexpr size_t UNBOUNDED{ 0U };
+    static constexpr uint32_t DEFAULT_SPIN_COUNT{ 10U };
+
 public:
     Queue( ) = default;
 
-    void
+    /// Bounded queue, producers wait (or fail) while there are capacity elements in the queue
+    explicit Queue( size_t capacity )
+        : m_capacity{ capacity }
+    {
+    }
+
+    /// Blocks while the queue is full. CLOSED if the queue is closed, the element is dropped then
+    OperationStatus
     push( const T& data )
+    {
+        return push( T{ data } );
+    }
+
+    OperationStatus
+    push( T&& data )
     {
         {
-            std::lock_guard< std::mutex > lock( m_mutex );
+            std::unique_lock< std::mutex > lock( m_mutex );
+            wait( lock, m_not_full_cv, [ this ]( ) { return has_space_or_closed( ); } );
             if( m_is_closed )
             {
-                return;
+                return OperationStatus::CLOSED;
             }
-            m_elements.push_front( std::move( data ) );
+            m_elements.push_back( std::move( data ) );
+            count_push( );
         }
-        m_cv.notify_one( );
+        notify( m_cv, 1U );
+        return OperationStatus::SUCCESS;
     }
 
-    void
-    push( T&& data )
+    /// UNSUCCESS when the queue is full, data is not moved from then
+    OperationStatus
+    try_push( T&& data )
     {
         {
             std::lock_guard< std::mutex > lock( m_mutex );
             if( m_is_closed )
             {
-                return;
+                return OperationStatus::CLOSED;
+            }
+            if( !has_space( ) )
+            {
+                return OperationStatus::UNSUCCESS;
+            }
+            m_elements.push_back( std::move( data ) );
+            count_push( );
+        }
+        notify( m_cv, 1U );
+        return OperationStatus::SUCCESS;
+    }
+
+    /// UNSUCCESS when the queue is still full after the timeout, data is not moved from then
+    template < class Rep, class Period >
+    OperationStatus
+    push_for( T&& data, const std::chrono::duration< Rep, Period >& timeout )
+    {
+        {
+            std::unique_lock< std::mutex > lock( m_mutex );
+            if( !wait_for( lock, m_not_full_cv, timeout, [ this ]( ) { return has_space_or_closed( ); } ) )
+            {
+                return OperationStatus::UNSUCCESS;
+            }
+            if( m_is_closed )
+            {
+                return OperationStatus::CLOSED;
             }
-            m_elements.push_front( std::move( data ) );
+            m_elements.push_back( std::move( data ) );
+            count_push( );
         }
-        m_cv.notify_one( );
+        notify( m_cv, 1U );
+        return OperationStatus::SUCCESS;
     }
 
+    /// Moves the elements of [first, last) in, one lock and one wakeup per batch.
+    /// Blocks while the queue is full, CLOSED if the queue is closed before all the elements are in
+    template < class InputIt >
+    OperationStatus
+    push_bulk( InputIt first, InputIt last )
+    {
+        while( first != last )
+        {
+            size_t count{ 0U };
+            {
+                std::unique_lock< std::mutex > lock( m_mutex );
+                wait( lock, m_not_full_cv, [ this ]( ) { return has_space_or_closed( ); } );
+                if( m_is_closed )
+                {
+                    return OperationStatus::CLOSED;
+                }
+                for( ; ( first != last ) && has_space( ); ++first, ++count )
+                {
+                    m_elements.push_back( std::move( *first ) );
+                    count_push( );
+                }
+            }
+            notify( m_cv, count );
+        }
+        return OperationStatus::SUCCESS;
+    }
 
     OperationStatus
     wait_pop( T& element )
     {
-        std::unique_lock< std::mutex > lock( m_mutex );
-        m_cv.wait( lock, [ this ]( ) { return is_not_empty_or_closed( ); } );
-        if( empty( lock ) )
         {
-            return OperationStatus::CLOSED;
+            std::unique_lock< std::mutex > lock( m_mutex );
+            wait( lock, m_cv, [ this ]( ) { return is_not_empty_or_closed( ); } );
+            if( empty( lock ) )
+            {
+                return OperationStatus::CLOSED;
+            }
+            element = std::move( m_elements.front( ) );
+            m_elements.pop_front( );
+            count_pop( );
         }
-        element = std::move( m_elements.front( ) );
-        m_elements.pop_front( );
+        notify( m_not_full_cv, 1U );
 
         return OperationStatus::SUCCESS;
     }
 
+    /// Polls the queue without the lock for a while before blocking in wait_pop( ).
+    /// Saves the sleep and the wakeup when the producer is expected to push soon
     OperationStatus
-    try_pop( T& value )
+    spin_wait_pop( T& element, uint32_t spin_count = DEFAULT_SPIN_COUNT )
+    {
+        Backoff backoff{ spin_count, 0U };
+        do
+        {
+            if( ( 0U != m_size_hint.load( std::memory_order_relaxed ) ) && ( OperationStatus::SUCCESS == try_pop( element ) ) )
+            {
+                return OperationStatus::SUCCESS;
+            }
+        } while( backoff.pause( ) );
+
+        return wait_pop( element );
+    }
+
+    /// UNSUCCESS when the queue is still empty after the timeout
+    template < class Rep, class Period >
+    OperationStatus
+    wait_pop_for( T& element, const std::chrono::duration< Rep, Period >& timeout )
     {
-        std::lock_guard< std::mutex > lock( m_mutex );
-        if( m_elements.empty( ) )
         {
-            return OperationStatus::UNSUCCESS;
+            std::unique_lock< std::mutex > lock( m_mutex );
+            if( !wait_for( lock, m_cv, timeout, [ this ]( ) { return is_not_empty_or_closed( ); } ) )
+            {
+                return OperationStatus::UNSUCCESS;
+            }
+            if( empty( lock ) )
+            {
+                return OperationStatus::CLOSED;
+            }
+            element = std::move( m_elements.front( ) );
+            m_elements.pop_front( );
+            count_pop( );
         }
+        notify( m_not_full_cv, 1U );
 
-        value = std::move( m_elements.front( ) );
-        m_elements.pop_front( );
+        return OperationStatus::SUCCESS;
+    }
+
+    /// Moves up to max_count elements to out, returns the number of moved elements
+    template < class OutputIt >
+    size_t
+    pop_bulk( OutputIt out, size_t max_count )
+    {
+        size_t count{ 0U };
+        {
+            std::lock_guard< std::mutex > lock( m_mutex );
+            count = pop_elements( out, max_count );
+        }
+        notify( m_not_full_cv, count );
+        return count;
+    }
+
+    /// Waits for at least one element and moves up to max_count elements to out.
+    /// Returns the number of moved elements, zero means the queue is closed
+    template < class OutputIt >
+    size_t
+    wait_pop_bulk( OutputIt out, size_t max_count )
+    {
+        size_t count{ 0U };
+        {
+            std::unique_lock< std::mutex > lock( m_mutex );
+            wait( lock, m_cv, [ this ]( ) { return is_not_empty_or_closed( ); } );
+            count = pop_elements( out, max_count );
+        }
+        notify( m_not_full_cv, count );
+        return count;
+    }
+
+    OperationStatus
+    try_pop( T& value )
+    {
+        {
+            std::lock_guard< std::mutex > lock( m_mutex );
+            if( m_elements.empty( ) )
+            {
+                return OperationStatus::UNSUCCESS;
+            }
+
+            value = std::move( m_elements.front( ) );
+            m_elements.pop_front( );
+            count_pop( );
+        }
+        notify( m_not_full_cv, 1U );
         return OperationStatus::SUCCESS;
     }
 
@@ -100,6 +274,8 @@ public:
             m_is_closed = true;
         }
         m_cv.notify_all( );
+        m_not_full_cv.notify_all( );
+        notify_signal( );
     }
 
     bool
@@ -116,7 +292,68 @@ public:
         return m_elements.empty( );
     }
 
+    size_t
+    size( ) const
+    {
+        std::lock_guard< std::mutex > guard( m_mutex );
+        return m_elements.size( );
+    }
+
+    /// Signal notified on every push and on close, used by QueueSet. nullptr detaches
+    void
+    set_signal( QueueSignal* signal ) noexcept
+    {
+        m_signal.store( signal, std::memory_order_release );
+    }
+
+    /// UNBOUNDED by default
+    size_t
+    capacity( ) const noexcept
+    {
+        return m_capacity;
+    }
+
+    /// Counting is done under the queue lock, so it costs a couple of increments per operation
+    void
+    set_metrics_enabled( bool is_enabled )
+    {
+        std::lock_guard< std::mutex > guard( m_mutex );
+        m_is_metrics_enabled = is_enabled;
+    }
+
+    QueueMetrics
+    get_metrics( ) const
+    {
+        std::lock_guard< std::mutex > guard( m_mutex );
+        QueueMetrics metrics{ m_metrics };
+        metrics.size = m_elements.size( );
+        return metrics;
+    }
+
 private:
+    /// Bookkeeping after the element is added, under the lock
+    void
+    count_push( ) noexcept
+    {
+        m_size_hint.store( m_elements.size( ), std::memory_order_relaxed );
+        if( m_is_metrics_enabled )
+        {
+            ++m_metrics.push_count;
+            m_metrics.max_size = std::max< uint64_t >( m_metrics.max_size, m_elements.size( ) );
+        }
+    }
+
+    /// Bookkeeping after the element is removed, under the lock
+    void
+    count_pop( ) noexcept
+    {
+        m_size_hint.store( m_elements.size( ), std::memory_order_relaxed );
+        if( m_is_metrics_enabled )
+        {
+            ++m_metrics.pop_count;
+        }
+    }
+
     bool
     empty( std::unique_lock< std::mutex >& /* m_mutex */ ) const noexcept
     {
@@ -129,12 +366,113 @@ private:
         return !m_elements.empty( ) || m_is_closed;
     }
 
+    bool
+    has_space( ) const noexcept
+    {
+        return ( UNBOUNDED == m_capacity ) || ( m_elements.size( ) < m_capacity );
+    }
+
+    bool
+    has_space_or_closed( ) const noexcept
+    {
+        return has_space( ) || m_is_closed;
+    }
+
+    std::atomic< uint32_t >&
+    get_waiting_count( const std::condition_variable& cv ) noexcept
+    {
+        return ( &cv == &m_cv ) ? m_waiting_consumers : m_waiting_producers;
+    }
+
+    template < class Predicate >
+    void
+    wait( std::unique_lock< std::mutex >& lock, std::condition_variable& cv, Predicate&& predicate )
+    {
+        std::atomic< uint32_t >& waiting_count = get_waiting_count( cv );
+        waiting_count.fetch_add( 1U, std::memory_order_relaxed );
+        cv.wait( lock, std::forward< Predicate >( predicate ) );
+        waiting_count.fetch_sub( 1U, std::memory_order_relaxed );
+    }
+
+    template < class Rep, class Period, class Predicate >
+    bool
+    wait_for( std::unique_lock< std::mutex >& lock,
+              std::condition_variable& cv,
+              const std::chrono::duration< Rep, Period >& timeout,
+              Predicate&& predicate )
+    {
+        std::atomic< uint32_t >& waiting_count = get_waiting_count( cv );
+        waiting_count.fetch_add( 1U, std::memory_order_relaxed );
+        const bool is_ready = cv.wait_for( lock, timeout, std::forward< Predicate >( predicate ) );
+        waiting_count.fetch_sub( 1U, std::memory_order_relaxed );
+        return is_ready;
+    }
+
+    void
+    notify_signal( )
+    {
+        if( QueueSignal* signal = m_signal.load( std::memory_order_acquire ) )
+        {
+            signal->notify( );
+        }
+    }
+
+    /// Single wakeup for the batch of count elements, no syscall when nobody sleeps.
+    /// Called after the unlock: a waiter registers under the lock before the predicate check,
+    /// so it is either visible here or sees the change and does not sleep
+    void
+    notify( std::condition_variable& cv, size_t count )
+    {
+        if( ( 0U != count ) && ( &cv == &m_cv ) )
+        {
+            notify_signal( );
+        }
+
+        if( ( 0U == count ) || ( 0U == get_waiting_count( cv ).load( std::memory_order_relaxed ) ) )
+        {
+            return;
+        }
+
+        if( 1U == count )
+        {
+            cv.notify_one( );
+        }
+        else
+        {
+            cv.notify_all( );
+        }
+    }
+
+    template < class OutputIt >
+    size_t
+    pop_elements( OutputIt& out, size_t max_count )
+    {
+        size_t count{ 0U };
+        for( ; ( count < max_count ) && !m_elements.empty( ); ++count )
+        {
+            *out = std::move( m_elements.front( ) );
+            ++out;
+            m_elements.pop_front( );
+            count_pop( );
+        }
+        return count;
+    }
+
 private:
     Container m_elements{ };
+    const size_t m_capacity{ UNBOUNDED };
 
     mutable std::mutex m_mutex{ };
     std::condition_variable m_cv{ };
+    std::condition_variable m_not_full_cv{ };
+    std::atomic< uint32_t > m_waiting_consumers{ 0U };
+    std::atomic< uint32_t > m_waiting_producers{ 0U };
+    std::atomic< size_t > m_size_hint{ 0U };  //< Size for the lock-free spinning
+    std::atomic< QueueSignal* > m_signal{ nullptr };
     bool m_is_closed{ false };
+
+    bool m_is_metrics_enabled{ false };
+    QueueMetrics m_metrics{ };
 };
 
 }  // namespace common
@@ -0,0 +1,184 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/QueueSet.hpp
+/// @brief Declaration select over several queues.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "uni/common/Defines.hpp"
+#include "uni/common/Queue.hpp"
+#include "uni/common/QueueSignal.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace uni
+{
+namespace common
+{
+/*
+ * Blocks the single consumer until any of the registered queues has an element.
+ * Works with every queue that has try_pop( ), closed( ) and set_signal( ): Queue, MpmcQueue, SpscQueue.
+ * Queues are drained by the weighted round robin: up to weight elements in a row from a queue before moving on.
+ * The queue belongs to one set at a time and has to outlive it.
+ * The set itself is not thread safe, it is used by one consumer thread.
+ */
+template < class T >
+class UNI_API QueueSet
+{
+public:
+    QueueSet( ) = default;
+
+    QueueSet( const QueueSet& ) = delete;
+    QueueSet& operator=( const QueueSet& ) = delete;
+
+    ~QueueSet( )
+    {
+        for( auto& entry : m_entries )
+        {
+            entry.set_signal( nullptr );
+        }
+    }
+
+    /// Returns the index of the queue reported by the pops
+    template < class QueueT >
+    size_t
+    add( QueueT& queue, uint32_t weight = 1U )
+    {
+        Entry entry;
+        entry.try_pop = [ &queue ]( T& element ) { return queue.try_pop( element ); };
+        entry.closed = [ &queue ]( ) { return queue.closed( ); };
+        entry.set_signal = [ &queue ]( QueueSignal* signal ) { queue.set_signal( signal ); };
+        entry.weight = std::max( weight, 1U );
+        m_entries.push_back( std::move( entry ) );
+
+        if( 1U == m_entries.size( ) )
+        {
+            m_credit = m_entries.front( ).weight;
+        }
+
+        // The elements pushed before are found by the first pop, no signal is needed for them
+        m_entries.back( ).set_signal( &m_signal );
+        return m_entries.size( ) - 1U;
+    }
+
+    size_t
+    size( ) const noexcept
+    {
+        return m_entries.size( );
+    }
+
+    /// UNSUCCESS when all the queues are empty, CLOSED when all of them are also closed
+    OperationStatus
+    try_pop( T& element, size_t& index )
+    {
+        if( pop_next( element, index ) )
+        {
+            return OperationStatus::SUCCESS;
+        }
+        return are_all_closed( ) && !pop_next( element, index ) ? OperationStatus::CLOSED : OperationStatus::UNSUCCESS;
+    }
+
+    /// Blocks until any queue has an element. CLOSED when all the queues are closed and empty
+    OperationStatus
+    wait_pop( T& element, size_t& index )
+    {
+        return wait_pop_until( element, index, std::chrono::steady_clock::time_point::max( ) );
+    }
+
+    /// UNSUCCESS when all the queues are still empty after the timeout
+    template < class Rep, class Period >
+    OperationStatus
+    wait_pop_for( T& element, size_t& index, const std::chrono::duration< Rep, Period >& timeout )
+    {
+        return wait_pop_until( element, index, std::chrono::steady_clock::now( ) + timeout );
+    }
+
+private:
+    struct Entry
+    {
+        std::function< OperationStatus( T& ) > try_pop{ };
+        std::function< bool( ) > closed{ };
+        std::function< void( QueueSignal* ) > set_signal{ };
+        uint32_t weight{ 1U };
+    };
+
+    OperationStatus
+    wait_pop_until( T& element, size_t& index, std::chrono::steady_clock::time_point deadline )
+    {
+        while( true )
+        {
+            const OperationStatus status = try_pop( element, index );
+            if( OperationStatus::UNSUCCESS != status )
+            {
+                return status;
+            }
+
+            // Re-check after taking the epoch: a push in between either is found now or changes the epoch
+            const uint64_t epoch = m_signal.prepare_wait( );
+            if( pop_next( element, index ) )
+            {
+                m_signal.cancel_wait( );
+                return OperationStatus::SUCCESS;
+            }
+
+            if( deadline == std::chrono::steady_clock::time_point::max( ) )
+            {
+                m_signal.wait( epoch );
+            }
+            else if( !m_signal.wait_until( epoch, deadline ) )
+            {
+                return OperationStatus::UNSUCCESS;
+            }
+        }
+    }
+
+    bool
+    pop_next( T& element, size_t& index )
+    {
+        const size_t count = m_entries.size( );
+        for( size_t i = 0U; i < count; ++i )
+        {
+            const size_t candidate = ( m_current + i ) % count;
+            if( OperationStatus::SUCCESS != m_entries[ candidate ].try_pop( element ) )
+            {
+                continue;
+            }
+
+            if( candidate != m_current )
+            {
+                m_current = candidate;
+                m_credit = m_entries[ candidate ].weight;
+            }
+            if( 0U == --m_credit )
+            {
+                m_current = ( m_current + 1U ) % count;
+                m_credit = m_entries[ m_current ].weight;
+            }
+
+            index = candidate;
+            return true;
+        }
+        return false;
+    }
+
+    bool
+    are_all_closed( ) const
+    {
+        return std::all_of( m_entries.begin( ), m_entries.end( ), []( const Entry& entry ) { return entry.closed( ); } );
+    }
+
+private:
+    std::vector< Entry > m_entries{ };
+    size_t m_current{ 0U };   //< Queue served now
+    uint32_t m_credit{ 0U };  //< Elements left to take from the current queue
+    QueueSignal m_signal{ };
+};
+
+}  // namespace common
+}  // namespace uni
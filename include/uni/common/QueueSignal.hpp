@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/QueueSignal.hpp
+/// @brief Declaration event count shared by the queues of the QueueSet.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "uni/common/Defines.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace uni
+{
+namespace common
+{
+/*
+ * Event count: the waiter takes the epoch with prepare_wait( ), checks its condition
+ * and sleeps only if nobody notified since then. notify( ) is one atomic increment
+ * and takes the mutex only when somebody sleeps.
+ */
+class UNI_API QueueSignal
+{
+public:
+    void
+    notify( )
+    {
+        m_epoch.fetch_add( 1U, std::memory_order_seq_cst );
+        if( m_waiting_count.load( std::memory_order_seq_cst ) > 0U )
+        {
+            std::lock_guard< std::mutex > lock( m_mutex );
+            m_cv.notify_all( );
+        }
+    }
+
+    /// Has to be followed by wait( ) or cancel_wait( )
+    uint64_t
+    prepare_wait( )
+    {
+        m_waiting_count.fetch_add( 1U, std::memory_order_seq_cst );
+        return m_epoch.load( std::memory_order_seq_cst );
+    }
+
+    void
+    cancel_wait( )
+    {
+        m_waiting_count.fetch_sub( 1U, std::memory_order_relaxed );
+    }
+
+    /// Returns false on timeout
+    bool
+    wait_until( uint64_t epoch, std::chrono::steady_clock::time_point deadline )
+    {
+        std::unique_lock< std::mutex > lock( m_mutex );
+        const bool is_notified = m_cv.wait_until( lock, deadline, [ this, epoch ] { return epoch != m_epoch.load( std::memory_order_seq_cst ); } );
+        m_waiting_count.fetch_sub( 1U, std::memory_order_relaxed );
+        return is_notified;
+    }
+
+    void
+    wait( uint64_t epoch )
+    {
+        std::unique_lock< std::mutex > lock( m_mutex );
+        m_cv.wait( lock, [ this, epoch ] { return epoch != m_epoch.load( std::memory_order_seq_cst ); } );
+        m_waiting_count.fetch_sub( 1U, std::memory_order_relaxed );
+    }
+
+private:
+    std::atomic< uint64_t > m_epoch{ 0U };
+    std::atomic< uint32_t > m_waiting_count{ 0U };
+    std::mutex m_mutex{ };
+    std::condition_variable m_cv{ };
+};
+
+}  // namespace common
+}  // namespace uni
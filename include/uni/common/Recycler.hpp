@@ -0,0 +1,241 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/Recycler.hpp
+/// @brief Declaration thread local cache of fixed size memory blocks.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "uni/common/Constants.hpp"
+#include "uni/common/Defines.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace uni
+{
+namespace common
+{
+/*
+ * Keeps released blocks in the thread local free list, so short living objects
+ * (tasks, future states) do not go to the heap in the steady state.
+ * Every block remembers the cache it came from. A block released by another thread (a stolen task,
+ * a future completed on a worker) is pushed to the lock-free remote list of its owner, and the owner takes
+ * the whole list back when its local list runs out: blocks do not drain from the submitting thread to the workers.
+ * The cache outlives its thread while any of its blocks is in use, the last release frees it.
+ */
+template < size_t BlockSize >
+class UNI_API Recycler
+{
+    static_assert( BlockSize >= sizeof( void* ), "Block should fit the free list node" );
+
+    struct Node
+    {
+        Node* next{ nullptr };
+    };
+
+    struct Cache
+    {
+        Node* head{ nullptr };  //< Owner only
+        size_t count{ 0U };
+        std::atomic< Node* > remote_head{ nullptr };
+        std::atomic< size_t > reference_count{ 1U };  //< The owner thread and the blocks in use
+    };
+
+    /// The owner is kept in front of the block, the block stays aligned to max_align_t
+    static constexpr size_t HEADER_SIZE{ alignof( std::max_align_t ) };
+
+    struct CacheHolder
+    {
+        ~CacheHolder( )
+        {
+            t_is_released = true;
+            if( cache )
+            {
+                free_list( cache->head );
+                free_list( cache->remote_head.exchange( nullptr, std::memory_order_acquire ) );
+                release( cache );
+            }
+        }
+
+        Cache* cache{ nullptr };
+    };
+
+public:
+    static void*
+    allocate( )
+    {
+        Cache* cache = local_cache( );
+        if( nullptr == cache )
+        {
+            return make_block( nullptr );
+        }
+
+        if( ( nullptr == cache->head ) && ( nullptr != cache->remote_head.load( std::memory_order_relaxed ) ) )
+        {
+            cache->head = cache->remote_head.exchange( nullptr, std::memory_order_acquire );
+            for( Node* node = cache->head; node; node = node->next )
+            {
+                ++cache->count;
+            }
+        }
+
+        cache->reference_count.fetch_add( 1U, std::memory_order_relaxed );
+        if( cache->head )
+        {
+            Node* node = cache->head;
+            cache->head = node->next;
+            --cache->count;
+            return node;
+        }
+
+        return make_block( cache );
+    }
+
+    static void
+    deallocate( void* block ) noexcept
+    {
+        Cache* owner = get_owner( block );
+        if( nullptr == owner )
+        {
+            ::operator delete( static_cast< unsigned char* >( block ) - HEADER_SIZE );
+            return;
+        }
+
+        if( owner != current_cache( ) )
+        {
+            Node* node = ::new( block ) Node{ owner->remote_head.load( std::memory_order_relaxed ) };
+            while( !owner->remote_head.compare_exchange_weak( node->next, node, std::memory_order_release, std::memory_order_relaxed ) )
+            {
+            }
+            release( owner );
+            return;
+        }
+
+        if( owner->count >= MAX_CACHED_BLOCKS )
+        {
+            ::operator delete( static_cast< unsigned char* >( block ) - HEADER_SIZE );
+            owner->reference_count.fetch_sub( 1U, std::memory_order_relaxed );
+            return;
+        }
+
+        owner->head = ::new( block ) Node{ owner->head };
+        ++owner->count;
+        owner->reference_count.fetch_sub( 1U, std::memory_order_relaxed );
+    }
+
+public:
+    static constexpr size_t MAX_CACHED_BLOCKS{ 1024U };
+
+private:
+    static void*
+    make_block( Cache* owner )
+    {
+        auto* memory = static_cast< unsigned char* >( ::operator new( HEADER_SIZE + BlockSize ) );
+        *reinterpret_cast< Cache** >( memory ) = owner;
+        return memory + HEADER_SIZE;
+    }
+
+    static Cache*
+    get_owner( void* block ) noexcept
+    {
+        return *reinterpret_cast< Cache** >( static_cast< unsigned char* >( block ) - HEADER_SIZE );
+    }
+
+    static void
+    free_list( Node* node ) noexcept
+    {
+        while( node )
+        {
+            Node* next = node->next;
+            ::operator delete( reinterpret_cast< unsigned char* >( node ) - HEADER_SIZE );
+            node = next;
+        }
+    }
+
+    /// The last reference frees the cache of the exited thread together with the blocks returned after the exit
+    static void
+    release( Cache* cache ) noexcept
+    {
+        if( 1U == cache->reference_count.fetch_sub( 1U, std::memory_order_acq_rel ) )
+        {
+            free_list( cache->remote_head.exchange( nullptr, std::memory_order_acquire ) );
+            delete cache;
+        }
+    }
+
+    /// nullptr once the thread's cache is released at the thread exit
+    static Cache*
+    local_cache( )
+    {
+        if( t_is_released )
+        {
+            return nullptr;
+        }
+
+        CacheHolder& holder = get_holder( );
+        if( nullptr == holder.cache )
+        {
+            holder.cache = new Cache( );
+        }
+        return holder.cache;
+    }
+
+    /// Does not create the cache: a thread that only releases the blocks of others does not need one
+    static Cache*
+    current_cache( ) noexcept
+    {
+        return t_is_released ? nullptr : get_holder( ).cache;
+    }
+
+    static CacheHolder&
+    get_holder( ) noexcept
+    {
+        thread_local CacheHolder holder;
+        return holder;
+    }
+
+    static thread_local bool t_is_released;  //< Trivially destructible, valid during the thread exit
+};
+
+template < size_t BlockSize >
+thread_local bool Recycler< BlockSize >::t_is_released{ false };
+
+/// Size class of the object, keeps number of the Recycler instantiations small
+template < class T >
+using RecyclerFor = Recycler< ( ( sizeof( T ) + CACHE_LINE_SIZE - 1U ) / CACHE_LINE_SIZE ) * CACHE_LINE_SIZE >;
+
+template < class T, class... Args >
+T*
+recycled_new( Args&&... args )
+{
+    static_assert( alignof( T ) <= alignof( std::max_align_t ), "Over-aligned types are not supported" );
+
+    void* block = RecyclerFor< T >::allocate( );
+    try
+    {
+        return ::new( block ) T( std::forward< Args >( args )... );
+    }
+    catch( ... )
+    {
+        RecyclerFor< T >::deallocate( block );
+        throw;
+    }
+}
+
+template < class T >
+void
+recycled_delete( T* object ) noexcept
+{
+    if( object )
+    {
+        object->~T( );
+        RecyclerFor< T >::deallocate( object );
+    }
+}
+
+}  // namespace common
+}  // namespace uni
@@ -0,0 +1,225 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/RingBuffer.hpp
+/// @brief Declaration growable ring buffer container.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "uni/common/Defines.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace uni
+{
+namespace common
+{
+/*
+ * FIFO container on the contiguous power-of-two ring, the default container of Queue.
+ * The storage grows twice when full and is never released until destruction,
+ * so the queue in the steady state does not allocate at all.
+ */
+template < class T >
+class UNI_API RingBuffer
+{
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    static constexpr size_t MIN_CAPACITY{ 16U };
+
+public:
+    RingBuffer( ) = default;
+
+    RingBuffer( const RingBuffer& ) = delete;
+    RingBuffer& operator=( const RingBuffer& ) = delete;
+
+    RingBuffer( RingBuffer&& other ) noexcept
+        : m_cells{ std::move( other.m_cells ) }
+        , m_capacity{ std::exchange( other.m_capacity, 0U ) }
+        , m_head{ std::exchange( other.m_head, 0U ) }
+        , m_size{ std::exchange( other.m_size, 0U ) }
+    {
+    }
+
+    RingBuffer&
+    operator=( RingBuffer&& other ) noexcept
+    {
+        if( this != &other )
+        {
+            clear( );
+            m_cells = std::move( other.m_cells );
+            m_capacity = std::exchange( other.m_capacity, 0U );
+            m_head = std::exchange( other.m_head, 0U );
+            m_size = std::exchange( other.m_size, 0U );
+        }
+        return *this;
+    }
+
+    ~RingBuffer( )
+    {
+        clear( );
+    }
+
+    void
+    push_back( const T& value )
+    {
+        emplace_back( value );
+    }
+
+    void
+    push_back( T&& value )
+    {
+        emplace_back( std::move( value ) );
+    }
+
+    template < class... Args >
+    T&
+    emplace_back( Args&&... args )
+    {
+        if( m_size == m_capacity )
+        {
+            grow( );
+        }
+
+        T* element = ::new( static_cast< void* >( m_cells[ ( m_head + m_size ) & ( m_capacity - 1U ) ].storage ) )
+            T( std::forward< Args >( args )... );
+        ++m_size;
+        return *element;
+    }
+
+    /// The container must not be empty
+    T&
+    front( ) noexcept
+    {
+        return *m_cells[ m_head ].data( );
+    }
+
+    const T&
+    front( ) const noexcept
+    {
+        return *m_cells[ m_head ].data( );
+    }
+
+    /// The container must not be empty
+    void
+    pop_front( ) noexcept
+    {
+        m_cells[ m_head ].data( )->~T( );
+        m_head = ( m_head + 1U ) & ( m_capacity - 1U );
+        --m_size;
+    }
+
+    bool
+    empty( ) const noexcept
+    {
+        return 0U == m_size;
+    }
+
+    size_t
+    size( ) const noexcept
+    {
+        return m_size;
+    }
+
+    size_t
+    capacity( ) const noexcept
+    {
+        return m_capacity;
+    }
+
+    /// Keeps the storage
+    void
+    clear( ) noexcept
+    {
+        while( !empty( ) )
+        {
+            pop_front( );
+        }
+        m_head = 0U;
+    }
+
+    void
+    reserve( size_t capacity )
+    {
+        while( m_capacity < capacity )
+        {
+            grow( );
+        }
+    }
+
+private:
+    struct Cell
+    {
+        alignas( T ) unsigned char storage[ sizeof( T ) ];
+
+        T*
+        data( ) noexcept
+        {
+            return std::launder( reinterpret_cast< T* >( storage ) );
+        }
+
+        const T*
+        data( ) const noexcept
+        {
+            return std::launder( reinterpret_cast< const T* >( storage ) );
+        }
+    };
+
+    /// Element by its position from the oldest one
+    T*
+    at( size_t position ) noexcept
+    {
+        return m_cells[ ( m_head + position ) & ( m_capacity - 1U ) ].data( );
+    }
+
+    void
+    grow( )
+    {
+        const size_t capacity = ( 0U == m_capacity ) ? MIN_CAPACITY : m_capacity * 2U;
+        auto cells = std::make_unique< Cell[] >( capacity );
+
+        // Unwraps the ring, the oldest element goes first. The old elements are destroyed only when all of them
+        // are in the new storage, so a throwing copy leaves the container as it was
+        size_t count = 0U;
+        try
+        {
+            for( ; count < m_size; ++count )
+            {
+                ::new( static_cast< void* >( cells[ count ].storage ) ) T( std::move_if_noexcept( *at( count ) ) );
+            }
+        }
+        catch( ... )
+        {
+            while( count > 0U )
+            {
+                cells[ --count ].data( )->~T( );
+            }
+            throw;
+        }
+
+        for( size_t i = 0U; i < m_size; ++i )
+        {
+            at( i )->~T( );
+        }
+
+        m_cells = std::move( cells );
+        m_capacity = capacity;
+        m_head = 0U;
+    }
+
+private:
+    std::unique_ptr< Cell[] > m_cells{ };
+    size_t m_capacity{ 0U };
+    size_t m_head{ 0U };  //< Index of the oldest element
+    size_t m_size{ 0U };
+};
+
+}  // namespace common
+}  // namespace uni
@@ -0,0 +1,333 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/SpscQueue.hpp
+/// @brief Declaration wait-free bounded single-producer single-consumer queue.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "uni/common/Backoff.hpp"
+#include "uni/common/Constants.hpp"
+#include "uni/common/Defines.hpp"
+#include "uni/common/Queue.hpp"
+#include "uni/common/QueueSignal.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace uni
+{
+namespace common
+{
+/*
+ * Ring buffer for exactly one producer thread and one consumer thread.
+ * try_push( ) and try_pop( ) are wait-free: one acquire load and one release store in the common case.
+ * Every side keeps a cached copy of the other side's index and re-reads the shared one
+ * only when the cached copy says the queue is full (empty), so the index lines are rarely bounced.
+ * Blocking calls spin first and sleep only when there is nothing to do,
+ * the opposite side takes the mutex only if the peer is actually sleeping. Until a side has slept once
+ * the opposite side does not even fence, so the queue used only by try_push( ) and try_pop( ) stays wait-free.
+ * Has the same push/try_pop/wait_pop/close contract as Queue.
+ */
+template < class T >
+class UNI_API SpscQueue
+{
+    using DataType = T;
+
+public:
+    static constexpr size_t DEFAULT_CAPACITY{ 1024U };
+
+public:
+    explicit SpscQueue( size_t capacity = DEFAULT_CAPACITY )
+        : m_mask{ round_up_to_power_of_two( capacity ) - 1U }
+        , m_cells{ std::make_unique< Cell[] >( m_mask + 1U ) }
+    {
+    }
+
+    SpscQueue( const SpscQueue& ) = delete;
+    SpscQueue& operator=( const SpscQueue& ) = delete;
+
+    ~SpscQueue( )
+    {
+        const size_t tail = m_tail.load( std::memory_order_acquire );
+        for( size_t head = m_head.load( std::memory_order_relaxed ); head != tail; ++head )
+        {
+            m_cells[ head & m_mask ].data( )->~T( );
+        }
+    }
+
+    /// Producer only. Blocks while the queue is full. CLOSED if the queue is closed, the element is dropped then
+    OperationStatus
+    push( const T& data )
+    {
+        T copy{ data };
+        return push( std::move( copy ) );
+    }
+
+    /// Producer only
+    OperationStatus
+    push( T&& data )
+    {
+        Backoff backoff{ SPIN_COUNT, YIELD_COUNT };
+        OperationStatus status{ OperationStatus::UNSUCCESS };
+        while( OperationStatus::UNSUCCESS == ( status = try_push( std::move( data ) ) ) )
+        {
+            if( !backoff.pause( ) )
+            {
+                wait( m_producer_mode, m_is_producer_waiting, m_not_full_cv, [ this ] { return size( ) <= m_mask; } );
+                backoff.reset( );
+            }
+        }
+        return status;
+    }
+
+    /// Producer only. UNSUCCESS when the queue is full, data is not moved from then
+    OperationStatus
+    try_push( T&& data )
+    {
+        if( m_is_closed.load( std::memory_order_acquire ) )
+        {
+            return OperationStatus::CLOSED;
+        }
+
+        const size_t tail = m_tail.load( std::memory_order_relaxed );
+        if( tail - m_cached_head > m_mask )
+        {
+            m_cached_head = m_head.load( std::memory_order_acquire );
+            if( tail - m_cached_head > m_mask )
+            {
+                return OperationStatus::UNSUCCESS;
+            }
+        }
+
+        ::new( static_cast< void* >( m_cells[ tail & m_mask ].storage ) ) T( std::move( data ) );
+        m_tail.store( tail + 1U, std::memory_order_release );
+
+        notify( m_consumer_mode, m_is_consumer_waiting, m_not_empty_cv );
+        notify_signal( );
+        return OperationStatus::SUCCESS;
+    }
+
+    /// Consumer only
+    OperationStatus
+    wait_pop( T& element )
+    {
+        Backoff backoff{ SPIN_COUNT, YIELD_COUNT };
+        while( true )
+        {
+            if( OperationStatus::SUCCESS == try_pop( element ) )
+            {
+                return OperationStatus::SUCCESS;
+            }
+
+            if( m_is_closed.load( std::memory_order_acquire ) )
+            {
+                // The last elements might be pushed right before the close
+                return ( OperationStatus::SUCCESS == try_pop( element ) ) ? OperationStatus::SUCCESS : OperationStatus::CLOSED;
+            }
+
+            if( !backoff.pause( ) )
+            {
+                wait( m_consumer_mode, m_is_consumer_waiting, m_not_empty_cv, [ this ] { return !empty( ); } );
+                backoff.reset( );
+            }
+        }
+    }
+
+    /// Consumer only
+    OperationStatus
+    try_pop( T& value )
+    {
+        const size_t head = m_head.load( std::memory_order_relaxed );
+        if( head == m_cached_tail )
+        {
+            m_cached_tail = m_tail.load( std::memory_order_acquire );
+            if( head == m_cached_tail )
+            {
+                return OperationStatus::UNSUCCESS;
+            }
+        }
+
+        T* element = m_cells[ head & m_mask ].data( );
+        value = std::move( *element );
+        element->~T( );
+        m_head.store( head + 1U, std::memory_order_release );
+
+        notify( m_producer_mode, m_is_producer_waiting, m_not_full_cv );
+        return OperationStatus::SUCCESS;
+    }
+
+    /// Elements already in the queue can still be popped
+    void
+    close( )
+    {
+        m_is_closed.store( true, std::memory_order_seq_cst );
+
+        std::lock_guard< std::mutex > lock( m_mutex );
+        m_not_empty_cv.notify_all( );
+        m_not_full_cv.notify_all( );
+        notify_signal( );
+    }
+
+    /// Signal notified on every push and on close, used by QueueSet. nullptr detaches
+    void
+    set_signal( QueueSignal* signal ) noexcept
+    {
+        m_signal.store( signal, std::memory_order_release );
+    }
+
+    bool
+    closed( ) const
+    {
+        return m_is_closed.load( std::memory_order_acquire );
+    }
+
+    /// Approximate when called from the third thread
+    bool
+    empty( ) const
+    {
+        return 0U == size( );
+    }
+
+    /// Approximate when called from the third thread
+    size_t
+    size( ) const
+    {
+        const size_t head = m_head.load( std::memory_order_acquire );
+        const size_t tail = m_tail.load( std::memory_order_acquire );
+        return ( tail > head ) ? tail - head : 0U;
+    }
+
+    size_t
+    capacity( ) const noexcept
+    {
+        return m_mask + 1U;
+    }
+
+private:
+    static constexpr uint32_t SPIN_COUNT{ 16U };
+    static constexpr uint32_t YIELD_COUNT{ 4U };
+    static constexpr std::chrono::milliseconds HANDSHAKE_WAIT{ 1 };
+
+    /// Whether the opposite side has to fence and check the sleeper on every operation
+    enum class BlockingMode : uint8_t
+    {
+        OFF,        //< Nobody has slept, the opposite side skips the fence
+        REQUESTED,  //< The sleeper wakes up by timeout, the opposite side might still skip the fence
+        ON          //< The opposite side has seen the request, it fences on every operation
+    };
+
+    struct Cell
+    {
+        alignas( T ) unsigned char storage[ sizeof( T ) ];
+
+        T*
+        data( ) noexcept
+        {
+            return std::launder( reinterpret_cast< T* >( storage ) );
+        }
+    };
+
+    static size_t
+    round_up_to_power_of_two( size_t value ) noexcept
+    {
+        size_t result{ 2U };
+        while( result < value )
+        {
+            result <<= 1U;
+        }
+        return result;
+    }
+
+    void
+    notify_signal( )
+    {
+        if( QueueSignal* signal = m_signal.load( std::memory_order_acquire ) )
+        {
+            signal->notify( );
+        }
+    }
+
+    void
+    notify( std::atomic< BlockingMode >& mode, const std::atomic< bool >& is_waiting, std::condition_variable& cv )
+    {
+        const BlockingMode blocking_mode = mode.load( std::memory_order_relaxed );
+        if( BlockingMode::OFF == blocking_mode )
+        {
+            return;
+        }
+        if( BlockingMode::REQUESTED == blocking_mode )
+        {
+            // Release: the sleeper that sees ON sees every change made before, including the ones not fenced
+            mode.store( BlockingMode::ON, std::memory_order_release );
+        }
+
+        // Pairs with the fence in wait( ): either the sleeper sees the change or we see the sleeper
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        if( is_waiting.load( std::memory_order_relaxed ) )
+        {
+            std::lock_guard< std::mutex > lock( m_mutex );
+            cv.notify_one( );
+        }
+    }
+
+    template < class Predicate >
+    void
+    wait( std::atomic< BlockingMode >& mode, std::atomic< bool >& is_waiting, std::condition_variable& cv, Predicate&& is_ready )
+    {
+        const auto is_woken = [ this, &is_ready ] { return is_ready( ) || m_is_closed.load( std::memory_order_acquire ); };
+
+        std::unique_lock< std::mutex > lock( m_mutex );
+        if( BlockingMode::OFF == mode.load( std::memory_order_relaxed ) )
+        {
+            mode.store( BlockingMode::REQUESTED, std::memory_order_relaxed );
+        }
+        is_waiting.store( true, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+
+        // Until the opposite side fences, its notification can be missed: the caller retries after the timeout
+        if( BlockingMode::ON == mode.load( std::memory_order_acquire ) )
+        {
+            cv.wait( lock, is_woken );
+        }
+        else
+        {
+            cv.wait_for( lock, HANDSHAKE_WAIT, is_woken );
+        }
+        is_waiting.store( false, std::memory_order_relaxed );
+    }
+
+private:
+    const size_t m_mask{ 0U };
+    const std::unique_ptr< Cell[] > m_cells{};
+
+    // Producer side
+    alignas( CACHE_LINE_SIZE ) std::atomic< size_t > m_tail{ 0U };
+    size_t m_cached_head{ 0U };
+
+    // Consumer side
+    alignas( CACHE_LINE_SIZE ) std::atomic< size_t > m_head{ 0U };
+    size_t m_cached_tail{ 0U };
+
+    // Sleeping side, touched only when a blocking call runs out of spinning
+    alignas( CACHE_LINE_SIZE ) std::atomic< bool > m_is_closed{ false };
+    std::atomic< bool > m_is_consumer_waiting{ false };
+    std::atomic< bool > m_is_producer_waiting{ false };
+    std::atomic< BlockingMode > m_consumer_mode{ BlockingMode::OFF };  //< Consumer sleeps, the producer fences
+    std::atomic< BlockingMode > m_producer_mode{ BlockingMode::OFF };  //< Producer sleeps, the consumer fences
+    std::mutex m_mutex{};
+    std::condition_variable m_not_empty_cv{};
+    std::condition_variable m_not_full_cv{};
+    std::atomic< QueueSignal* > m_signal{ nullptr };
+};
+
+}  // namespace common
+}  // namespace uni
@@ -0,0 +1,403 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/Task.hpp
+/// @brief Declaration move-only task with inline storage and its future.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "uni/common/Defines.hpp"
+#include "uni/common/Recycler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace uni
+{
+namespace common
+{
+/*
+ * Move-only replacement of the std::function< void( ) >.
+ * Callables up to INLINE_STORAGE_SIZE bytes are stored inline, bigger ones go to the heap.
+ */
+class UNI_API Task
+{
+    struct VTable
+    {
+        void ( *invoke )( void* storage );
+        void ( *move )( void* destination, void* source ) noexcept;
+        void ( *destroy )( void* storage ) noexcept;
+    };
+
+public:
+    static constexpr size_t INLINE_STORAGE_SIZE{ 64U };
+
+    template < class F >
+    static constexpr bool is_stored_inline = ( sizeof( F ) <= INLINE_STORAGE_SIZE ) && ( alignof( F ) <= alignof( std::max_align_t ) )
+                                             && std::is_nothrow_move_constructible< F >::value;
+
+public:
+    Task( ) noexcept = default;
+
+    template < class F, class = std::enable_if_t< !std::is_same< std::decay_t< F >, Task >::value > >
+    Task( F&& function )  // NOLINT(google-explicit-constructor)
+    {
+        using Function = std::decay_t< F >;
+
+        if constexpr( is_stored_inline< Function > )
+        {
+            ::new( static_cast< void* >( m_storage ) ) Function( std::forward< F >( function ) );
+            m_vtable = &INLINE_VTABLE< Function >;
+        }
+        else
+        {
+            *reinterpret_cast< Function** >( m_storage ) = new Function( std::forward< F >( function ) );
+            m_vtable = &HEAP_VTABLE< Function >;
+        }
+    }
+
+    Task( Task&& other ) noexcept
+    {
+        move_from( other );
+    }
+
+    Task&
+    operator=( Task&& other ) noexcept
+    {
+        if( this != &other )
+        {
+            reset( );
+            move_from( other );
+        }
+        return *this;
+    }
+
+    Task( const Task& ) = delete;
+    Task& operator=( const Task& ) = delete;
+
+    ~Task( )
+    {
+        reset( );
+    }
+
+    explicit operator bool( ) const noexcept
+    {
+        return m_vtable != nullptr;
+    }
+
+    void
+    operator( )( )
+    {
+        m_vtable->invoke( m_storage );
+    }
+
+    void
+    reset( ) noexcept
+    {
+        if( m_vtable )
+        {
+            m_vtable->destroy( m_storage );
+            m_vtable = nullptr;
+        }
+    }
+
+private:
+    void
+    move_from( Task& other ) noexcept
+    {
+        if( other.m_vtable )
+        {
+            other.m_vtable->move( m_storage, other.m_storage );
+            m_vtable = other.m_vtable;
+            other.reset( );
+        }
+    }
+
+    template < class F >
+    static constexpr VTable INLINE_VTABLE{
+        []( void* storage ) { ( *static_cast< F* >( storage ) )( ); },
+        []( void* destination, void* source ) noexcept { ::new( destination ) F( std::move( *static_cast< F* >( source ) ) ); },
+        []( void* storage ) noexcept { static_cast< F* >( storage )->~F( ); } };
+
+    template < class F >
+    static constexpr VTable HEAP_VTABLE{
+        []( void* storage ) { ( **static_cast< F** >( storage ) )( ); },
+        []( void* destination, void* source ) noexcept {
+            *static_cast< F** >( destination ) = *static_cast< F** >( source );
+            *static_cast< F** >( source ) = nullptr;
+        },
+        []( void* storage ) noexcept { delete *static_cast< F** >( storage ); } };
+
+private:
+    alignas( std::max_align_t ) unsigned char m_storage[ INLINE_STORAGE_SIZE ];
+    const VTable* m_vtable{ nullptr };
+};
+
+
+namespace detail
+{
+/// Result of the task shared between the Promise (pool side) and the TaskFuture (caller side)
+template < class R >
+class FutureState
+{
+public:
+    static FutureState*
+    create( )
+    {
+        return recycled_new< FutureState >( );
+    }
+
+    void
+    release( ) noexcept
+    {
+        if( 1U == m_references.fetch_sub( 1U, std::memory_order_acq_rel ) )
+        {
+            recycled_delete( this );
+        }
+    }
+
+    template < class F, class Tuple >
+    void
+    run( F& function, Tuple& args ) noexcept
+    {
+        try
+        {
+            if constexpr( std::is_void< R >::value )
+            {
+                std::apply( function, std::move( args ) );
+            }
+            else
+            {
+                m_value.emplace( std::apply( function, std::move( args ) ) );
+            }
+        }
+        catch( ... )
+        {
+            m_exception = std::current_exception( );
+        }
+        complete( );
+    }
+
+    void
+    abandon( ) noexcept
+    {
+        m_exception = std::make_exception_ptr( std::future_error( std::future_errc::broken_promise ) );
+        complete( );
+    }
+
+    bool
+    is_ready( ) const noexcept
+    {
+        return m_is_ready.load( std::memory_order_acquire );
+    }
+
+    void
+    wait( )
+    {
+        if( is_ready( ) )
+        {
+            return;
+        }
+
+        std::unique_lock< std::mutex > lock( m_mutex );
+        m_cv.wait( lock, [ this ] { return is_ready( ); } );
+    }
+
+    template < class Rep, class Period >
+    bool
+    wait_for( const std::chrono::duration< Rep, Period >& timeout )
+    {
+        if( is_ready( ) )
+        {
+            return true;
+        }
+
+        std::unique_lock< std::mutex > lock( m_mutex );
+        return m_cv.wait_for( lock, timeout, [ this ] { return is_ready( ); } );
+    }
+
+    R
+    get( )
+    {
+        wait( );
+        if( m_exception )
+        {
+            std::rethrow_exception( m_exception );
+        }
+
+        if constexpr( !std::is_void< R >::value )
+        {
+            return std::move( *m_value );
+        }
+    }
+
+private:
+    void
+    complete( ) noexcept
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        m_is_ready.store( true, std::memory_order_release );
+        m_cv.notify_all( );
+    }
+
+private:
+    using Value = std::conditional_t< std::is_void< R >::value, bool, R >;
+
+    std::atomic< uint32_t > m_references{ 2U };  //< Promise and TaskFuture
+    std::atomic< bool > m_is_ready{ false };
+    std::mutex m_mutex{};
+    std::condition_variable m_cv{};
+    std::optional< Value > m_value{};
+    std::exception_ptr m_exception{};
+};
+
+/// Pool side of the FutureState. Breaks the promise if the task is destroyed without running
+template < class R >
+class Promise
+{
+public:
+    explicit Promise( FutureState< R >* state ) noexcept
+        : m_state{ state }
+    {
+    }
+
+    Promise( Promise&& other ) noexcept
+        : m_state{ std::exchange( other.m_state, nullptr ) }
+    {
+    }
+
+    Promise( const Promise& ) = delete;
+    Promise& operator=( const Promise& ) = delete;
+    Promise& operator=( Promise&& ) = delete;
+
+    ~Promise( )
+    {
+        if( m_state )
+        {
+            m_state->abandon( );
+            m_state->release( );
+        }
+    }
+
+    template < class F, class Tuple >
+    void
+    run( F& function, Tuple& args ) noexcept
+    {
+        if( m_state )
+        {
+            m_state->run( function, args );
+            std::exchange( m_state, nullptr )->release( );
+        }
+    }
+
+private:
+    FutureState< R >* m_state{ nullptr };
+};
+}  // namespace detail
+
+
+/*
+ * Caller side of the task result. Dropping the future does not cancel the task.
+ */
+template < class R >
+class TaskFuture
+{
+public:
+    TaskFuture( ) noexcept = default;
+
+    explicit TaskFuture( detail::FutureState< R >* state ) noexcept
+        : m_state{ state }
+    {
+    }
+
+    TaskFuture( TaskFuture&& other ) noexcept
+        : m_state{ std::exchange( other.m_state, nullptr ) }
+    {
+    }
+
+    TaskFuture&
+    operator=( TaskFuture&& other ) noexcept
+    {
+        if( this != &other )
+        {
+            reset( );
+            m_state = std::exchange( other.m_state, nullptr );
+        }
+        return *this;
+    }
+
+    TaskFuture( const TaskFuture& ) = delete;
+    TaskFuture& operator=( const TaskFuture& ) = delete;
+
+    ~TaskFuture( )
+    {
+        reset( );
+    }
+
+    /// False when the task was not accepted by the pool
+    bool
+    valid( ) const noexcept
+    {
+        return m_state != nullptr;
+    }
+
+    bool
+    is_ready( ) const noexcept
+    {
+        return m_state && m_state->is_ready( );
+    }
+
+    void
+    wait( ) const
+    {
+        if( m_state )
+        {
+            m_state->wait( );
+        }
+    }
+
+    template < class Rep, class Period >
+    bool
+    wait_for( const std::chrono::duration< Rep, Period >& timeout ) const
+    {
+        return m_state && m_state->wait_for( timeout );
+    }
+
+    /// Waits for the result, rethrows the task's exception. Should be called once
+    R
+    get( )
+    {
+        if( !m_state )
+        {
+            throw std::future_error( std::future_errc::no_state );
+        }
+
+        return m_state->get( );
+    }
+
+private:
+    void
+    reset( ) noexcept
+    {
+        if( m_state )
+        {
+            std::exchange( m_state, nullptr )->release( );
+        }
+    }
+
+private:
+    detail::FutureState< R >* m_state{ nullptr };
+};
+
+}  // namespace common
+}  // namespace uni
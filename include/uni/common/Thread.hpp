@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "uni/common/Affinity.hpp"
 #include "uni/common/Constants.hpp"
 #include "uni/common/Defines.hpp"
 #include "uni/common/ErrorCode.hpp"
@@ -37,8 +38,9 @@ public:
         std::string name{};
         Repeat repeat_type{ Repeat::ONCE };
         uint64_t timeout_ms{ DEFAULT_TIMEOUT_MS };
+        CpuSet cpu_affinity{};  //< Empty - the thread is not pinned
 
-        LOG_CLASS( Settings, LOG_IT( name ), LOG_IT( repeat_type ), LOG_IT( timeout_ms ) );
+        LOG_CLASS( Settings, LOG_IT( name ), LOG_IT( repeat_type ), LOG_IT( timeout_ms ), LOG_IT( cpu_affinity ) );
     };
 
 public:
@@ -9,14 +9,25 @@
 #pragma once
 
 #include "uni/common/Defines.hpp"
+#include "uni/common/Metrics.hpp"
 #include "uni/common/Queue.hpp"
+#include "uni/common/Task.hpp"
 #include "uni/common/Thread.hpp"
+#include "uni/common/TimerWheel.hpp"
+#include "uni/common/WorkStealingDeque.hpp"
 
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <future>
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace uni
@@ -31,26 +42,494 @@ using DefaultVoidStdFunction = std::function< void( ) >;
 class UNI_API ThreadPool
 {
 public:
+    using Clock = std::chrono::steady_clock;
+    using TimerHandle = TimerWheel::Handle;
+
+    /// Priority lanes of the shared queue
+    enum class Priority
+    {
+        HIGH,
+        NORMAL,  //< Default for submit( ) without priority
+        LOW,
+
+        COUNT  //< Maximum value, used for range check
+    };
+
+    /// Work-stealing worker takes its own deque, then the shared (injection) queue, then steals from a random worker.
+    /// The HIGH lane and the starving lanes go before all of them, the LOW lane after
+    enum class Scheduling
+    {
+        SHARED_QUEUE,   //< All workers pop tasks from the one shared queue
+        WORK_STEALING,  //< Per-worker deques with stealing, the shared queue is used for external and prioritized submits
+    };
+
+    /// What an idle worker escalates to when there are no tasks
+    enum class IdleStrategy
+    {
+        SPIN,   //< Pause instruction only, lowest latency, burns the core
+        YIELD,  //< Spin, then yield forever
+        PARK,   //< Spin, yield, then sleep until submit( ) wakes the worker
+    };
+
+    struct IdleSettings
+    {
+        IdleStrategy strategy{ IdleStrategy::PARK };
+        uint32_t spin_count{ 64U };                      //< Rounds of the pause bursts
+        uint32_t yield_count{ 16U };                     //< Rounds of the yield after spinning
+        uint64_t park_timeout_ms{ DEFAULT_TIMEOUT_MS };  //< Upper bound of one park
+
+        LOG_CLASS( IdleSettings, LOG_IT( strategy ), LOG_IT( spin_count ), LOG_IT( yield_count ), LOG_IT( park_timeout_ms ) );
+    };
+
+    /// Pool grows up to max_thread_count when tasks pile up and shrinks to min_thread_count when workers are idle.
+    /// Idle workers retire from the park, so shrinking needs IdleStrategy::PARK
+    struct ElasticSettings
+    {
+        uint32_t min_thread_count{ 1U };
+        uint32_t max_thread_count{ 0U };    //< 0 - fixed size pool of thread_count workers
+        uint32_t grow_queue_depth{ 16U };   //< Pending tasks that add a worker when nobody is parked
+        uint64_t grow_wait_ms{ 20U };       //< Time without started tasks while tasks are pending that adds a worker
+        uint64_t keep_alive_ms{ 10000U };   //< Idle time after which a worker above min_thread_count retires
+        uint64_t check_interval_ms{ 5U };   //< Period of the queue depth check
+
+        LOG_CLASS( ElasticSettings,
+                   LOG_IT( min_thread_count ),
+                   LOG_IT( max_thread_count ),
+                   LOG_IT( grow_queue_depth ),
+                   LOG_IT( grow_wait_ms ),
+                   LOG_IT( keep_alive_ms ),
+                   LOG_IT( check_interval_ms ) );
+    };
+
+    /// Worker to CPU assignment
+    enum class Placement
+    {
+        NONE,            //< Workers inherit thread_settings.cpu_affinity
+        COMPACT,         //< Worker per logical CPU, siblings of the core first, then the next core, package, node
+        SCATTER,         //< Worker per logical CPU, round-robin over packages, physical cores before their siblings
+        PHYSICAL_CORES,  //< Worker per physical core, hyper-thread siblings are not used
+        NUMA_NODE,       //< All the workers float over the CPUs of numa_node
+    };
+
+    struct PlacementSettings
+    {
+        Placement policy{ Placement::NONE };
+        uint32_t numa_node{ 0U };  //< Used by Placement::NUMA_NODE
+
+        LOG_CLASS( PlacementSettings, LOG_IT( policy ), LOG_IT( numa_node ) );
+    };
+
     struct Settings
     {
         Thread::Settings thread_settings{};
-        uint32_t thread_count{ std::thread::hardware_concurrency( ) };
+        uint32_t thread_count{ std::thread::hardware_concurrency( ) };  //< Initial number of workers
+        Scheduling scheduling{ Scheduling::SHARED_QUEUE };
+        IdleSettings idle{};
+        ElasticSettings elastic{};
+        uint64_t priority_aging_ms{ 100U };  //< Lower lane waiting longer is served before higher ones, 0 - no aging
+        PlacementSettings placement{};
+        uint64_t timer_resolution_ms{ 1U };  //< Tick of the timer wheel behind submit_after( ) and submit_every( )
+        bool enable_metrics{ false };        //< Per-worker counters and latency histograms, see get_metrics( )
+
+        LOG_CLASS( Settings,
+                   LOG_IT( thread_settings ),
+                   LOG_IT( thread_count ),
+                   LOG_IT( scheduling ),
+                   LOG_IT( idle ),
+                   LOG_IT( elastic ),
+                   LOG_IT( priority_aging_ms ),
+                   LOG_IT( placement ),
+                   LOG_IT( timer_resolution_ms ),
+                   LOG_IT( enable_metrics ) );
+    };
+
+    enum class ShutdownMode
+    {
+        DRAIN,    //< Run all the queued tasks, including the ones they submit
+        CANCEL,   //< Drop the queued tasks, wait only for the running ones
+        TIMEOUT,  //< Drain until the timeout, then cancel the rest
+    };
+
+    struct ShutdownStats
+    {
+        uint64_t completed_count{ 0U };  //< Tasks run by the pool over its lifetime
+        uint64_t dropped_count{ 0U };    //< Queued tasks dropped by the shutdown, their futures get broken_promise
+        uint64_t expired_count{ 0U };    //< Tasks dropped because of the missed deadline
+        bool is_timed_out{ false };      //< TIMEOUT mode ran out of time with tasks left
+
+        LOG_CLASS( ShutdownStats, LOG_IT( completed_count ), LOG_IT( dropped_count ), LOG_IT( expired_count ), LOG_IT( is_timed_out ) );
+    };
+
+    struct WorkerMetrics
+    {
+        uint32_t index{ 0U };
+        bool is_active{ false };
+        uint64_t executed_count{ 0U };
+        double busy_ratio{ 0.0 };      //< Share of the pool uptime spent in the tasks
+        HistogramSnapshot wait_time{};  //< Enqueue to start of the tasks run by the worker, ns
+        HistogramSnapshot run_time{};   //< Task duration, ns
+
+        LOG_CLASS( WorkerMetrics, LOG_IT( index ), LOG_IT( is_active ), LOG_IT( executed_count ), LOG_IT( busy_ratio ), LOG_IT( wait_time ), LOG_IT( run_time ) );
+    };
+
+    /// Snapshot of the pool, collected without stopping the workers
+    struct Metrics
+    {
+        uint64_t uptime_ms{ 0U };
+        uint32_t thread_count{ 0U };
+        uint64_t executed_count{ 0U };
+        uint64_t expired_count{ 0U };
+        uint64_t local_queue_depth{ 0U };  //< Tasks in the work-stealing deques
+        QueueMetrics high_lane{};
+        QueueMetrics normal_lane{};
+        QueueMetrics low_lane{};
+        HistogramSnapshot wait_time{};  //< Merged over the workers
+        HistogramSnapshot run_time{};
+        std::vector< WorkerMetrics > workers{};
+
+        LOG_CLASS( Metrics,
+                   LOG_IT( uptime_ms ),
+                   LOG_IT( thread_count ),
+                   LOG_IT( executed_count ),
+                   LOG_IT( expired_count ),
+                   LOG_IT( local_queue_depth ),
+                   LOG_IT( high_lane ),
+                   LOG_IT( normal_lane ),
+                   LOG_IT( low_lane ),
+                   LOG_IT( wait_time ),
+                   LOG_IT( run_time ),
+                   LOG_IT( workers ) );
+    };
+
+    /*
+     * Base of the awaiters of the pool, see uni/common/Coroutine.hpp. Written against the coroutine handle
+     * as a template, so the header stays usable without C++20.
+     * The resume queued to the pool owns the suspended coroutine. Dropped without running (the shutdown drops
+     * the queued tasks and the pending timers), it resumes the coroutine with std::future_error( broken_promise ),
+     * so the frames up the continuation chain finish instead of leaking.
+     */
+    class ResumeAwaiter
+    {
+    public:
+        bool
+        await_ready( ) const noexcept
+        {
+            return false;
+        }
+
+        void
+        await_resume( ) const
+        {
+            if( m_is_cancelled )
+            {
+                throw std::future_error( std::future_errc::broken_promise );
+            }
+        }
+
+    protected:
+        template < class Handle >
+        class Resume
+        {
+        public:
+            Resume( Handle handle, ResumeAwaiter& awaiter ) noexcept
+                : m_handle{ handle }
+                , m_awaiter{ &awaiter }
+            {
+            }
+
+            Resume( Resume&& other ) noexcept
+                : m_handle{ std::exchange( other.m_handle, nullptr ) }
+                , m_awaiter{ other.m_awaiter }
+            {
+            }
+
+            Resume( const Resume& ) = delete;
+            Resume& operator=( const Resume& ) = delete;
+            Resume& operator=( Resume&& ) = delete;
+
+            ~Resume( )
+            {
+                // The rejected resume is handed back to await_suspend( ), which continues the coroutine itself
+                if( m_handle && !m_awaiter->m_is_rejected )
+                {
+                    m_awaiter->m_is_cancelled = true;
+                    m_handle.resume( );
+                }
+            }
+
+            void
+            operator( )( )
+            {
+                std::exchange( m_handle, nullptr ).resume( );
+            }
+
+        private:
+            Handle m_handle{};
+            ResumeAwaiter* m_awaiter{ nullptr };
+        };
+
+        /// The pool leaves the rejected task with the caller, so the resume is dropped after the flag is set
+        bool
+        reject( ) noexcept
+        {
+            m_is_rejected = true;
+            return false;
+        }
 
-        LOG_CLASS( Settings, LOG_IT( thread_settings ), LOG_IT( thread_count ) );
+    private:
+        bool m_is_rejected{ false };   //< Set before the resume is dropped by the submitting thread
+        bool m_is_cancelled{ false };  //< Set before the dropped resume continues the coroutine
+    };
+
+    /// Awaitable that moves the awaiting coroutine to a worker of the pool
+    class ScheduleAwaiter : public ResumeAwaiter
+    {
+    public:
+        ScheduleAwaiter( ThreadPool& pool, Priority priority ) noexcept
+            : m_pool{ pool }
+            , m_priority{ priority }
+        {
+        }
+
+        /// The resume fits into the Task inline storage, so the hop allocates nothing.
+        /// Returns false (the coroutine continues on the current thread) when the pool is on shutdown
+        template < class Handle >
+        bool
+        await_suspend( Handle handle )
+        {
+            Task task{ Resume< Handle >{ handle, *this } };
+            return ( ErrorCode::NONE == m_pool.push_task( std::move( task ), m_priority, Clock::time_point::max( ) ) ) || reject( );
+        }
+
+    private:
+        ThreadPool& m_pool;
+        const Priority m_priority{ Priority::NORMAL };
+    };
+
+    /// Awaitable that resumes the coroutine on a worker of the pool after the delay, without occupying a worker meanwhile
+    class SleepAwaiter : public ResumeAwaiter
+    {
+    public:
+        SleepAwaiter( ThreadPool& pool, Clock::duration delay ) noexcept
+            : m_pool{ pool }
+            , m_delay{ delay }
+        {
+        }
+
+        /// Returns false (the coroutine continues on the current thread) when the pool is on shutdown
+        template < class Handle >
+        bool
+        await_suspend( Handle handle )
+        {
+            Task task{ Resume< Handle >{ handle, *this } };
+            return m_pool.add_timer( Clock::now( ) + m_delay, Clock::duration::zero( ), std::move( task ) ).valid( ) || reject( );
+        }
+
+    private:
+        ThreadPool& m_pool;
+        const Clock::duration m_delay{};
     };
 
 public:
     ThreadPool( const Settings& settings );
     ~ThreadPool( );
 
-    /// Add new task to the queue
+    /// Add new task to the queue.
+    /// In WORK_STEALING mode tasks submitted from the pool's worker go to the worker's local deque
     ErrorCode submit( const DefaultVoidStdFunction& task );
 
+    /// Number of workers running at the moment
+    uint32_t get_thread_count( ) const;
+
+    /// Add new task to the queue, the result is delivered through the returned future.
+    /// Small callables are stored without heap allocation, the future state is recycled.
+    /// Returns invalid future when the pool is on shutdown
+    template < class F,
+               class... Args,
+               class = std::enable_if_t< ( sizeof...( Args ) > 0U ) || !std::is_same< std::decay_t< F >, DefaultVoidStdFunction >::value > >
+    auto
+    submit( F&& function, Args&&... args ) -> TaskFuture< std::invoke_result_t< std::decay_t< F >, std::decay_t< Args >... > >
+    {
+        return submit_to_lane( Priority::NORMAL, Clock::time_point::max( ), std::forward< F >( function ), std::forward< Args >( args )... );
+    }
+
+    /// Add new task to the priority lane. Higher lanes are drained first, lower lanes are aged.
+    /// The task is dropped without running when it is dequeued after the deadline, its future gets broken_promise
+    ErrorCode submit( const DefaultVoidStdFunction& task, Priority priority, Clock::time_point deadline = Clock::time_point::max( ) );
+
+    template < class F, class = std::enable_if_t< !std::is_same< std::decay_t< F >, DefaultVoidStdFunction >::value > >
+    auto
+    submit( F&& function, Priority priority, Clock::time_point deadline = Clock::time_point::max( ) )
+        -> TaskFuture< std::invoke_result_t< std::decay_t< F > > >
+    {
+        return submit_to_lane( priority, deadline, std::forward< F >( function ) );
+    }
+
+    /// Number of tasks dropped because of the missed deadline
+    uint64_t get_expired_count( ) const;
+
+    /// Blocks until every submitted task has finished or was dropped, returns TIMEOUT if the timeout passed first.
+    /// Tasks the timers fire later are not waited for. Must not be called from a worker of the pool
+    ErrorCode wait_idle( Clock::duration timeout = Clock::duration::max( ) );
+
+    /// Stops the timers and the workers. Tasks submitted from outside are rejected from now on,
+    /// tasks submitted by the running tasks are accepted while the pool drains.
+    /// The destructor calls shutdown( ShutdownMode::CANCEL ) if the pool was not shut down before
+    ShutdownStats shutdown( ShutdownMode mode, Clock::duration timeout = Clock::duration::zero( ) );
+
+    /// Latencies and lane counters are collected only with Settings::enable_metrics,
+    /// the task and thread counters are always there
+    Metrics get_metrics( ) const;
+
+    /// Submits the task to the pool after the delay. One timer thread serves all the timers of the pool,
+    /// it is started by the first call. Returns invalid handle when the pool is on shutdown
+    template < class F >
+    TimerHandle
+    submit_after( Clock::duration delay, F&& function )
+    {
+        return add_timer( Clock::now( ) + delay, Clock::duration::zero( ), Task{ std::forward< F >( function ) } );
+    }
+
+    /// Submits the task every period, the first time after one period. Fires are not skipped while
+    /// the previous run is in progress, so a task longer than the period runs concurrently with itself
+    template < class F >
+    TimerHandle
+    submit_every( Clock::duration period, F&& function )
+    {
+        REQUIRED_COMPONENT( LogComponent::POOL, period > Clock::duration::zero( ), "Period must be positive", TimerHandle{ } );
+
+        return add_timer( Clock::now( ) + period, period, Task{ std::forward< F >( function ) } );
+    }
+
+    /// Stops the timer. A fire already submitted to the pool still runs.
+    /// Returns NOT_FOUND if the one-shot timer already fired or the timer was cancelled
+    ErrorCode cancel( const TimerHandle& handle );
+
+    /// co_await pool.schedule( ) continues the coroutine on a worker of the pool.
+    /// Throws std::future_error( broken_promise ) in the coroutine when the shutdown drops the queued resume
+    ScheduleAwaiter
+    schedule( Priority priority = Priority::NORMAL ) noexcept
+    {
+        return ScheduleAwaiter{ *this, priority };
+    }
+
+private:
+    class TaskRunner;
+    class Supervisor;
+    class TimerRunner;
+
+    struct LaneTask
+    {
+        Task task{};
+        Clock::time_point deadline{ Clock::time_point::max( ) };
+        Clock::time_point enqueue_time{ };  //< Set only when the metrics are enabled
+    };
+
+    struct alignas( CACHE_LINE_SIZE ) Lane
+    {
+        Queue< LaneTask > queue{};
+        std::atomic< uint32_t > pending_count{ 0U };
+        std::atomic< Clock::rep > waiting_since{ 0 };  //< Approximate enqueue time of the lane's head
+    };
+
+    template < class F, class... Args >
+    auto
+    submit_to_lane( Priority priority, Clock::time_point deadline, F&& function, Args&&... args )
+        -> TaskFuture< std::invoke_result_t< std::decay_t< F >, std::decay_t< Args >... > >
+    {
+        using Result = std::invoke_result_t< std::decay_t< F >, std::decay_t< Args >... >;
+
+        REQUIRED_COMPONENT( LogComponent::POOL, is_accepting_tasks( ), "Thread pool is on shutdown", TaskFuture< Result >{ } );
+
+        auto* state = detail::FutureState< Result >::create( );
+        TaskFuture< Result > future{ state };
+
+        const ErrorCode result = push_task( [ promise = detail::Promise< Result >{ state },
+                                               function = std::forward< F >( function ),
+                                               args = std::make_tuple( std::forward< Args >( args )... ) ]( ) mutable { promise.run( function, args ); },
+                                             priority,
+                                             deadline );
+
+        // The pool was shut down after the check above, the rejected task breaks its promise when destroyed
+        return ( ErrorCode::NONE == result ) ? std::move( future ) : TaskFuture< Result >{ };
+    }
+
+    bool is_accepting_tasks( ) const;
+    /// The rejected task is left with the caller
+    ErrorCode push_task( Task&& task, Priority priority, Clock::time_point deadline );
+    void finish_task( );
+    bool pop_lane_task( Priority priority, LaneTask& task );
+    bool pop_starving_lane_task( LaneTask& task );
+    bool run_next_task( TaskRunner& runner );
+    bool steal_task( TaskRunner& thief, LaneTask*& task );
+
+    bool has_pending_tasks( ) const;
+    void park( const TaskRunner& runner );
+    void wake_one( );
+    void wake_all( );
+
+    bool is_elastic( ) const;
+    size_t get_pending_task_count( ) const;
+    void adjust_size( );
+    bool start_worker( );
+    bool try_retire( );
+
+    /// The rejected task is left with the caller
+    TimerHandle add_timer( Clock::time_point due, Clock::duration period, Task&& task );
+    void run_timers( const TimerRunner& runner );
+    void wake_timers( );
+
 private:
+    const Settings m_settings{};
+    const Clock::time_point m_start_time{ Clock::now( ) };
+
     std::atomic< bool > m_is_on_shutdown{ false };
-    Queue< DefaultVoidStdFunction > m_queue{};
-    std::vector< std::unique_ptr< uni::common::Thread > > m_threads{};
+    std::atomic< bool > m_is_draining{ false };  //< Workers still submit while the pool drains on shutdown
+    std::atomic< bool > m_is_shut_down{ false };
+    std::atomic< bool > m_is_stopped{ false };  //< Set on shutdown before the workers are joined, the queued tasks are not run any more
+    std::array< Lane, static_cast< size_t >( Priority::COUNT ) > m_lanes{};
+    std::atomic< uint64_t > m_expired_count{ 0U };
+    std::vector< std::unique_ptr< TaskRunner > > m_threads{};  //< Slots for max_thread_count workers
+
+    // Elastic sizing
+    uint32_t m_min_thread_count{ 0U };
+    std::atomic< uint32_t > m_active_count{ 0U };
+    std::mutex m_resize_mutex{};
+    std::unique_ptr< Supervisor > m_supervisor{};
+    uint64_t m_last_executed_count{ 0U };                              //< Supervisor only
+    std::chrono::steady_clock::time_point m_last_progress_time{ };    //< Supervisor only
+
+    // Parking of the idle workers
+    std::atomic< uint32_t > m_parked_count{ 0U };
+    std::mutex m_park_mutex{};
+    std::condition_variable m_park_cv{};
+    uint32_t m_wakeup_count{ 0U };  //< Guarded by m_park_mutex, wakeups not consumed yet
+
+    // Quiescence: tasks submitted, but not finished or dropped yet
+    alignas( CACHE_LINE_SIZE ) std::atomic< uint64_t > m_outstanding_count{ 0U };
+    std::atomic< uint64_t > m_dropped_count{ 0U };
+    std::mutex m_idle_mutex{};
+    std::condition_variable m_idle_cv{};
+
+    // Delayed and periodic tasks, guarded by m_timer_mutex
+    std::mutex m_timer_mutex{};
+    std::condition_variable m_timer_cv{};
+    TimerWheel m_timer_wheel;
+    Clock::time_point m_timer_wake_time{ Clock::time_point::max( ) };  //< Planned wakeup of the timer thread
+    std::vector< Task > m_dropped_timer_tasks{};                       //< Fired on shutdown, destroyed outside the lock
+    std::unique_ptr< TimerRunner > m_timer_runner{};
 };
 
+LOG_ENUM( ThreadPool::Scheduling, LOG_E( ThreadPool::Scheduling::SHARED_QUEUE ), LOG_E( ThreadPool::Scheduling::WORK_STEALING ) );
+LOG_ENUM( ThreadPool::Priority, LOG_E( ThreadPool::Priority::HIGH ), LOG_E( ThreadPool::Priority::NORMAL ), LOG_E( ThreadPool::Priority::LOW ) );
+LOG_ENUM( ThreadPool::Placement,
+          LOG_E( ThreadPool::Placement::NONE ),
+          LOG_E( ThreadPool::Placement::COMPACT ),
+          LOG_E( ThreadPool::Placement::SCATTER ),
+          LOG_E( ThreadPool::Placement::PHYSICAL_CORES ),
+          LOG_E( ThreadPool::Placement::NUMA_NODE ) );
+LOG_ENUM( ThreadPool::ShutdownMode, LOG_E( ThreadPool::ShutdownMode::DRAIN ), LOG_E( ThreadPool::ShutdownMode::CANCEL ), LOG_E( ThreadPool::ShutdownMode::TIMEOUT ) );
+LOG_ENUM( ThreadPool::IdleStrategy, LOG_E( ThreadPool::IdleStrategy::SPIN ), LOG_E( ThreadPool::IdleStrategy::YIELD ), LOG_E( ThreadPool::IdleStrategy::PARK ) );
+
 }  // namespace common
 }  // namespace uni
@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/TimerWheel.hpp
+/// @brief Declaration hierarchical timer wheel.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+/// @note Thanks to the "Hashed and Hierarchical Timing Wheels" by George Varghese and Tony Lauck
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "uni/common/Defines.hpp"
+#include "uni/common/Log.hpp"
+#include "uni/common/Task.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace uni
+{
+namespace common
+{
+/*
+ * Timers grouped into LEVEL_COUNT wheels of SLOT_COUNT slots, every level is SLOT_COUNT times coarser.
+ * Timers of the coarse levels are cascaded down when the finer wheel wraps.
+ * Add and cancel are O(1): entries are intrusive lists in a slab addressed by the handle.
+ * The class is not thread safe, the owner serializes the calls.
+ */
+class UNI_API TimerWheel
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using DueCallback = std::function< void( Task&& ) >;
+
+    static constexpr uint32_t SLOT_BITS{ 8U };
+    static constexpr uint32_t SLOT_COUNT{ 1U << SLOT_BITS };
+    static constexpr uint32_t LEVEL_COUNT{ 4U };  //< 2^32 ticks range, ~49 days with 1 ms resolution
+
+    /// Identifies the timer, stays safe to use after the timer fired or was cancelled
+    struct Handle
+    {
+        uint32_t index{ std::numeric_limits< uint32_t >::max( ) };
+        uint32_t generation{ 0U };
+
+        bool
+        valid( ) const noexcept
+        {
+            return index != std::numeric_limits< uint32_t >::max( );
+        }
+
+        LOG_CLASS( Handle, LOG_IT( index ), LOG_IT( generation ) );
+    };
+
+public:
+    explicit TimerWheel( Clock::duration resolution, Clock::time_point start = Clock::now( ) );
+
+    /// One-shot timer for zero period, otherwise periodic with the first fire at due.
+    /// Due time in the past fires on the next tick
+    Handle add( Clock::time_point due, Clock::duration period, Task&& task );
+
+    /// Returns false if the timer already fired (one-shot) or was cancelled
+    bool cancel( const Handle& handle );
+
+    size_t size( ) const noexcept;
+    bool empty( ) const noexcept;
+
+    /// Fires all the timers due up to now. Periodic timers are rearmed, missed periods are coalesced
+    void advance( Clock::time_point now, const DueCallback& on_due );
+
+    /// Removes all the timers without firing them, the tasks of the one-shot timers are handed to on_drop
+    void clear( const DueCallback& on_drop );
+
+    /// Time of the next tick that has to be processed, max( ) for the empty wheel
+    Clock::time_point get_next_expiry( ) const;
+
+private:
+    static constexpr uint32_t INVALID_INDEX{ std::numeric_limits< uint32_t >::max( ) };
+    static constexpr uint32_t SLOT_MASK{ SLOT_COUNT - 1U };
+
+    struct Entry
+    {
+        Task task{};                             //< One-shot timer
+        std::shared_ptr< Task > periodic_task{};  //< Periodic timer, shared by the fires in flight
+        uint64_t due_tick{ 0U };
+        uint64_t period_ticks{ 0U };
+        uint32_t prev{ INVALID_INDEX };
+        uint32_t next{ INVALID_INDEX };  //< Next entry of the slot or of the free list
+        uint32_t slot{ INVALID_INDEX };
+        uint32_t generation{ 0U };
+    };
+
+    uint64_t to_tick_floor( Clock::time_point time ) const;
+    uint64_t to_tick_ceil( Clock::time_point time ) const;
+
+    uint32_t allocate( );
+    void release( uint32_t index );
+    void link( uint32_t index );
+    void unlink( uint32_t index );
+    uint32_t detach_slot( uint32_t slot );
+    void fire_slot( uint32_t slot, uint64_t target_tick, const DueCallback& on_due );
+    void cascade_slot( uint32_t slot );
+
+private:
+    const Clock::duration m_resolution{};
+    const Clock::time_point m_start{};
+
+    uint64_t m_current_tick{ 0U };  //< Last processed tick
+    size_t m_size{ 0U };
+    std::vector< Entry > m_entries{};
+    uint32_t m_free_head{ INVALID_INDEX };
+    std::array< uint32_t, SLOT_COUNT * LEVEL_COUNT > m_slots{};  //< Heads of the slot lists
+};
+
+}  // namespace common
+}  // namespace uni
@@ -0,0 +1,203 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/WorkStealingDeque.hpp
+/// @brief Declaration lock-free work stealing deque.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+/// @note Thanks to the "Correct and Efficient Work-Stealing for Weak Memory Models" by N.M. Le, A. Pop, A. Cohen, F.Z. Nardelli
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "uni/common/Constants.hpp"
+#include "uni/common/Defines.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace uni
+{
+namespace common
+{
+/*
+ * Chase-Lev deque. Only the owner thread calls push( ) and pop( ) (LIFO end),
+ * any thread may call steal( ) (FIFO end).
+ * Elements are stored in atomics, so T should be trivially copyable (usually a pointer).
+ */
+template < class T >
+class UNI_API WorkStealingDeque
+{
+    static_assert( std::is_trivially_copyable< T >::value, "WorkStealingDeque element should be trivially copyable" );
+
+    class Array
+    {
+    public:
+        explicit Array( int64_t capacity )
+            : m_capacity{ capacity }
+            , m_mask{ capacity - 1 }
+            , m_elements{ std::make_unique< std::atomic< T >[] >( static_cast< size_t >( capacity ) ) }
+        {
+        }
+
+        int64_t
+        capacity( ) const noexcept
+        {
+            return m_capacity;
+        }
+
+        void
+        put( int64_t index, T value ) noexcept
+        {
+            m_elements[ index & m_mask ].store( value, std::memory_order_relaxed );
+        }
+
+        T
+        get( int64_t index ) const noexcept
+        {
+            return m_elements[ index & m_mask ].load( std::memory_order_relaxed );
+        }
+
+        std::unique_ptr< Array >
+        copy( int64_t bottom, int64_t top, int64_t capacity ) const
+        {
+            auto array = std::make_unique< Array >( capacity );
+            for( int64_t i = top; i != bottom; ++i )
+            {
+                array->put( i, get( i ) );
+            }
+            return array;
+        }
+
+    private:
+        const int64_t m_capacity;
+        const int64_t m_mask;
+        std::unique_ptr< std::atomic< T >[] > m_elements;
+    };
+
+public:
+    /// @param capacity Initial capacity, rounded up to the power of two
+    explicit WorkStealingDeque( size_t capacity = DEFAULT_CAPACITY )
+    {
+        int64_t rounded{ 1 };
+        while( rounded < static_cast< int64_t >( capacity ) )
+        {
+            rounded <<= 1;
+        }
+
+        m_arrays.emplace_back( std::make_unique< Array >( rounded ) );
+        m_array.store( m_arrays.back( ).get( ), std::memory_order_relaxed );
+    }
+
+    WorkStealingDeque( const WorkStealingDeque& ) = delete;
+    WorkStealingDeque& operator=( const WorkStealingDeque& ) = delete;
+
+    /// Owner only
+    void
+    push( T value )
+    {
+        const int64_t bottom = m_bottom.load( std::memory_order_relaxed );
+        const int64_t top = m_top.load( std::memory_order_acquire );
+        Array* array = m_array.load( std::memory_order_relaxed );
+
+        if( bottom - top > array->capacity( ) - 1 )
+        {
+            // Old arrays are kept alive because thieves might still read them
+            m_arrays.emplace_back( array->copy( bottom, top, array->capacity( ) * 2 ) );
+            array = m_arrays.back( ).get( );
+            m_array.store( array, std::memory_order_release );
+        }
+
+        array->put( bottom, value );
+        m_bottom.store( bottom + 1, std::memory_order_release );
+    }
+
+    /// Owner only. Moves the elements to the array allocated and touched by the calling thread,
+    /// so with the first-touch policy the storage lands on the caller's NUMA node
+    void
+    relocate( )
+    {
+        const int64_t bottom = m_bottom.load( std::memory_order_relaxed );
+        const int64_t top = m_top.load( std::memory_order_acquire );
+        const Array* array = m_array.load( std::memory_order_relaxed );
+
+        m_arrays.emplace_back( array->copy( bottom, top, array->capacity( ) ) );
+        m_array.store( m_arrays.back( ).get( ), std::memory_order_release );
+    }
+
+    /// Owner only
+    bool
+    pop( T& value )
+    {
+        const int64_t bottom = m_bottom.load( std::memory_order_relaxed ) - 1;
+        Array* array = m_array.load( std::memory_order_relaxed );
+        m_bottom.store( bottom, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        int64_t top = m_top.load( std::memory_order_relaxed );
+
+        if( top > bottom )
+        {
+            m_bottom.store( bottom + 1, std::memory_order_relaxed );
+            return false;
+        }
+
+        value = array->get( bottom );
+        if( top != bottom )
+        {
+            return true;
+        }
+
+        // The last element, race with thieves
+        const bool is_won = m_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed );
+        m_bottom.store( bottom + 1, std::memory_order_relaxed );
+        return is_won;
+    }
+
+    /// Any thread
+    bool
+    steal( T& value )
+    {
+        int64_t top = m_top.load( std::memory_order_acquire );
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        const int64_t bottom = m_bottom.load( std::memory_order_acquire );
+
+        if( top >= bottom )
+        {
+            return false;
+        }
+
+        const Array* array = m_array.load( std::memory_order_acquire );
+        value = array->get( top );
+        return m_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed );
+    }
+
+    /// Approximate, might be outdated right after the call
+    size_t
+    size( ) const noexcept
+    {
+        const int64_t bottom = m_bottom.load( std::memory_order_relaxed );
+        const int64_t top = m_top.load( std::memory_order_relaxed );
+        return bottom > top ? static_cast< size_t >( bottom - top ) : 0U;
+    }
+
+    bool
+    empty( ) const noexcept
+    {
+        return size( ) == 0U;
+    }
+
+public:
+    static constexpr size_t DEFAULT_CAPACITY{ 256U };
+
+private:
+    alignas( CACHE_LINE_SIZE ) std::atomic< int64_t > m_top{ 0 };
+    alignas( CACHE_LINE_SIZE ) std::atomic< int64_t > m_bottom{ 0 };
+    std::atomic< Array* > m_array{ nullptr };
+
+    // Owner only
+    std::vector< std::unique_ptr< Array > > m_arrays{};
+};
+
+}  // namespace common
+}  // namespace uni
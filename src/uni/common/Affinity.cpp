@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/Affinity.cpp
+/// @brief Implementation CPU topology and thread affinity helpers.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define UNI_LOG_COMPONENT ::uni::common::LogComponent::THREAD
+
+#include "uni/common/Affinity.hpp"
+#include "uni/common/Log.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+
+#if defined( __WIN64__ )
+#include <windows.h>
+#elif defined( __linux__ )
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace uni
+{
+namespace common
+{
+namespace
+{
+const std::string SYSFS_CPU_PATH{ "/sys/devices/system/cpu/" };
+const std::string SYSFS_NODE_PATH{ "/sys/devices/system/node/" };
+
+bool
+read_first_line( const std::string& path, std::string& line )
+{
+    std::ifstream file( path );
+    return static_cast< bool >( std::getline( file, line ) );
+}
+
+bool
+read_number( const std::string& path, uint32_t& value )
+{
+    std::string line;
+    if( !read_first_line( path, line ) )
+    {
+        return false;
+    }
+
+    try
+    {
+        value = static_cast< uint32_t >( std::stoul( line ) );
+    }
+    catch( const std::exception& )
+    {
+        return false;
+    }
+    return true;
+}
+
+/// Parses the kernel cpu list format, e.g. "0-3,8,10-11"
+CpuSet
+parse_cpu_list( const std::string& list )
+{
+    CpuSet cpu_set;
+    std::stringstream stream( list );
+    std::string range;
+    while( std::getline( stream, range, ',' ) )
+    {
+        try
+        {
+            const auto dash = range.find( '-' );
+            const auto first = static_cast< uint32_t >( std::stoul( range.substr( 0U, dash ) ) );
+            const auto last = ( dash == std::string::npos ) ? first : static_cast< uint32_t >( std::stoul( range.substr( dash + 1U ) ) );
+            for( uint32_t cpu = first; cpu <= last; ++cpu )
+            {
+                cpu_set.add( cpu );
+            }
+        }
+        catch( const std::exception& )
+        {
+            LOG_WARNING_MSG( "Invalid cpu list: ", list );
+            return CpuSet{ };
+        }
+    }
+    return cpu_set;
+}
+
+std::vector< CpuInfo >
+get_flat_topology( )
+{
+    std::vector< CpuInfo > topology;
+    const uint32_t count = std::max( 1U, std::thread::hardware_concurrency( ) );
+    for( uint32_t cpu = 0U; cpu < count; ++cpu )
+    {
+        topology.push_back( CpuInfo{ cpu, cpu, 0U, 0U } );
+    }
+    return topology;
+}
+}  // namespace
+
+
+std::vector< CpuInfo >
+get_cpu_topology( )
+{
+    std::string online;
+    if( !read_first_line( SYSFS_CPU_PATH + "online", online ) )
+    {
+        return get_flat_topology( );
+    }
+
+    const CpuSet online_cpus = parse_cpu_list( online );
+
+    std::vector< CpuInfo > topology;
+    for( const auto cpu : online_cpus.cpus( ) )
+    {
+        const std::string cpu_path = SYSFS_CPU_PATH + "cpu" + std::to_string( cpu ) + "/topology/";
+
+        CpuInfo info{ cpu, cpu, 0U, 0U };
+        read_number( cpu_path + "core_id", info.core );
+        read_number( cpu_path + "physical_package_id", info.package );
+        topology.push_back( info );
+    }
+
+    // Node of every CPU, machines without NUMA have no node directories
+    for( uint32_t node = 0U;; ++node )
+    {
+        std::string list;
+        if( !read_first_line( SYSFS_NODE_PATH + "node" + std::to_string( node ) + "/cpulist", list ) )
+        {
+            break;
+        }
+
+        const CpuSet node_cpus = parse_cpu_list( list );
+        for( auto& info : topology )
+        {
+            if( node_cpus.contains( info.cpu ) )
+            {
+                info.node = node;
+            }
+        }
+    }
+
+    if( topology.empty( ) )
+    {
+        return get_flat_topology( );
+    }
+
+    std::sort( topology.begin( ), topology.end( ), []( const CpuInfo& lhs, const CpuInfo& rhs ) {
+        return std::tie( lhs.node, lhs.package, lhs.core, lhs.cpu ) < std::tie( rhs.node, rhs.package, rhs.core, rhs.cpu );
+    } );
+    return topology;
+}
+
+CpuSet
+get_numa_node_cpus( uint32_t node )
+{
+    std::string list;
+    if( read_first_line( SYSFS_NODE_PATH + "node" + std::to_string( node ) + "/cpulist", list ) )
+    {
+        return parse_cpu_list( list );
+    }
+
+    // No NUMA information, the whole machine is the node 0
+    CpuSet cpu_set;
+    if( node == 0U )
+    {
+        for( const auto& info : get_cpu_topology( ) )
+        {
+            cpu_set.add( info.cpu );
+        }
+    }
+    return cpu_set;
+}
+
+ErrorCode
+set_current_thread_affinity( const CpuSet& cpu_set )
+{
+#if defined( __linux__ )
+    cpu_set_t mask;
+    CPU_ZERO( &mask );
+    if( cpu_set.empty( ) )
+    {
+        for( const auto& info : get_cpu_topology( ) )
+        {
+            CPU_SET( info.cpu, &mask );
+        }
+    }
+    else
+    {
+        for( const auto cpu : cpu_set.cpus( ) )
+        {
+            REQUIRED( cpu < CPU_SETSIZE, "CPU index is out of range", ErrorCode::INVALID_PARAM );
+            CPU_SET( cpu, &mask );
+        }
+    }
+
+    const int result = pthread_setaffinity_np( pthread_self( ), sizeof( mask ), &mask );
+    REQUIRED( result == 0, "pthread_setaffinity_np failed", ErrorCode::INTERNAL );
+    return ErrorCode::NONE;
+#elif defined( __WIN64__ )
+    DWORD_PTR mask{ 0U };
+    for( const auto cpu : cpu_set.cpus( ) )
+    {
+        REQUIRED( cpu < sizeof( DWORD_PTR ) * 8U, "CPU index is out of range", ErrorCode::INVALID_PARAM );
+        mask |= DWORD_PTR{ 1U } << cpu;
+    }
+
+    if( cpu_set.empty( ) )
+    {
+        DWORD_PTR system_mask{ 0U };
+        GetProcessAffinityMask( GetCurrentProcess( ), &mask, &system_mask );
+    }
+
+    REQUIRED( SetThreadAffinityMask( GetCurrentThread( ), mask ) != 0, "SetThreadAffinityMask failed", ErrorCode::INTERNAL );
+    return ErrorCode::NONE;
+#else
+    // macOS has only affinity hints through thread_policy_set
+    LOG_DEBUG_MSG( "Thread affinity is not supported: ", cpu_set );
+    return ErrorCode::NOT_FOUND;
+#endif
+}
+
+}  // namespace common
+}  // namespace uni
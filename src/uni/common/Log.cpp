@@ -7,10 +7,728 @@
 
 #include "uni/common/Log.hpp"
 
+#include "uni/common/MpmcQueue.hpp"
+#include "uni/common/QueueSignal.hpp"
+#include "uni/common/SpscQueue.hpp"
+#include "uni/common/Thread.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <streambuf>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 namespace uni
 {
 namespace common
 {
+std::atomic< LogLevel > g_log_levels[ static_cast< size_t >( LogComponent::COUNT ) ]{
+    LogLevel::DEBUG, LogLevel::DEBUG, LogLevel::DEBUG, LogLevel::DEBUG };
+
+static_assert( 4U == static_cast< size_t >( LogComponent::COUNT ), "Every component needs the initial level" );
+
+namespace
+{
+thread_local bool t_is_log_writer{ false };  //< The writer must not wait for itself
+
+/// Set when the thread's binary buffer is released at the thread exit, the thread logs the text after that
+thread_local bool t_is_binary_buffer_released{ false };
+
+std::atomic< uint64_t > g_next_writer_id{ 1U };
+
+/// Trivially destructible, so valid during the thread exit too
+thread_local const char* t_thread_name{ nullptr };
+
+/// Set when the thread's staging line is destroyed at the thread exit, the records are formatted on the stack after that
+thread_local bool t_is_staging_released{ false };
+
+/// Names are never freed: the binary records keep the pointers and there are only so many thread names
+const char*
+intern_thread_name( const std::string& name )
+{
+    static std::mutex* s_mutex = new std::mutex( );
+    static auto* s_names = new std::unordered_set< std::string >( );
+
+    std::lock_guard< std::mutex > lock( *s_mutex );
+    return s_names->insert( name ).first->c_str( );
+}
+
+void
+write_thread( std::ostream& ostream, std::thread::id thread_id, const char* thread_name )
+{
+    ostream << "\""
+            << "Thread:" << thread_id;
+    if( nullptr != thread_name )
+    {
+        ostream << ":" << thread_name;
+    }
+    ostream << "\""
+            << " ";
+}
+
+/// Appends to the string, which keeps its capacity between the records
+class LineBuffer : public std::streambuf
+{
+public:
+    std::string&
+    line( ) noexcept
+    {
+        return m_line;
+    }
+
+protected:
+    int_type
+    overflow( int_type ch ) override
+    {
+        if( !traits_type::eq_int_type( ch, traits_type::eof( ) ) )
+        {
+            m_line.push_back( traits_type::to_char_type( ch ) );
+        }
+        return traits_type::not_eof( ch );
+    }
+
+    std::streamsize
+    xsputn( const char* data, std::streamsize size ) override
+    {
+        m_line.append( data, static_cast< size_t >( size ) );
+        return size;
+    }
+
+private:
+    std::string m_line{};
+};
+
+/// Reusable line of the logging thread with the cached thread prefix
+struct Staging
+{
+    Staging( )
+    {
+        line.reserve( 256U );
+    }
+
+    ~Staging( )
+    {
+        t_is_staging_released = true;
+    }
+
+    /// A manipulator or a failed operator<< of the previous record must not affect the next one
+    void
+    reset_stream( )
+    {
+        stream.clear( );
+        stream.flags( flags );
+        stream.precision( precision );
+        stream.fill( fill );
+        stream.width( 0 );
+    }
+
+    void
+    update_prefix( )
+    {
+        std::ostringstream ostream;
+        write_thread( ostream, std::this_thread::get_id( ), t_thread_name );
+        prefix = ostream.str( );
+        prefix_name = t_thread_name;
+    }
+
+    LineBuffer buffer{};
+    std::string& line{ buffer.line( ) };
+    std::ostream stream{ &buffer };
+    const std::ios_base::fmtflags flags{ stream.flags( ) };
+    const std::streamsize precision{ stream.precision( ) };
+    const char fill{ stream.fill( ) };
+    std::string prefix{};
+    const char* prefix_name{ nullptr };  //< Thread name the prefix was made with
+    bool is_busy{ false };               //< The record is being formatted, a nested call uses its own stream
+};
+
+Staging*
+get_staging( )
+{
+    if( t_is_staging_released )
+    {
+        return nullptr;
+    }
+
+    thread_local Staging staging;
+    return &staging;
+}
+
+/// Binary records of one logging thread
+struct ThreadBuffer
+{
+    explicit ThreadBuffer( size_t capacity )
+        : records{ capacity }
+    {
+    }
+
+    SpscQueue< BinaryLogRecord > records;
+    std::atomic< bool > is_orphan{ false };  //< The thread exited or switched to the newer writer
+    std::atomic< bool > is_pushing{ false };  //< Written by the owner thread only, close( ) waits for it
+};
+
+struct ThreadBufferHolder
+{
+    ~ThreadBufferHolder( )
+    {
+        t_is_binary_buffer_released = true;
+        if( buffer )
+        {
+            buffer->is_orphan.store( true, std::memory_order_release );
+        }
+    }
+
+    uint64_t writer_id{ 0U };
+    std::shared_ptr< ThreadBuffer > buffer{};
+};
+}  // namespace
+
+class Log::AsyncWriter : public Thread
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+public:
+    AsyncWriter( const AsyncSettings& settings, const std::atomic< LogSink* >& sink, std::mutex& ostream_mutex )
+        : Thread{ make_thread_settings( ) }
+        , m_settings{ settings }
+        , m_sink{ sink }
+        , m_ostream_mutex{ ostream_mutex }
+        , m_records{ std::max< size_t >( settings.capacity, 2U ) }
+        , m_spare_lines{ std::max< size_t >( settings.capacity, 2U ) }
+    {
+        m_records.set_signal( &m_signal );
+    }
+
+    ~AsyncWriter( ) override
+    {
+        if( is_running( ) )
+        {
+            stop( );
+        }
+    }
+
+    /// CLOSED when the writer is stopped, the caller writes the record itself then.
+    /// The pushed record is replaced by a spare line of the earlier records, so the caller keeps a buffer with the capacity
+    OperationStatus
+    push( std::string& record )
+    {
+        // Pairs with close( ): either the pusher sees the closing or close( ) waits for the pusher
+        m_pusher_count.fetch_add( 1U, std::memory_order_seq_cst );
+        OperationStatus status{ OperationStatus::CLOSED };
+        if( !m_is_closing.load( std::memory_order_seq_cst ) )
+        {
+            status = ( ( LogOverflowPolicy::BLOCK == m_settings.overflow_policy ) && !t_is_log_writer )
+                         ? m_records.push( std::move( record ) )
+                         : m_records.try_push( std::move( record ) );
+        }
+        m_pusher_count.fetch_sub( 1U, std::memory_order_release );
+
+        if( OperationStatus::UNSUCCESS == status )
+        {
+            m_dropped_count.fetch_add( 1U, std::memory_order_relaxed );
+            return OperationStatus::SUCCESS;
+        }
+
+        if( OperationStatus::SUCCESS == status )
+        {
+            std::string spare;
+            if( OperationStatus::SUCCESS == m_spare_lines.try_pop( spare ) )
+            {
+                record = std::move( spare );
+            }
+        }
+        return status;
+    }
+
+    /// False if the writer is closed or the thread is exiting, the caller writes the text then
+    bool
+    push_binary( BinaryLogRecord& record )
+    {
+        ThreadBuffer* buffer = get_thread_buffer( );
+        if( nullptr == buffer )
+        {
+            return false;
+        }
+
+        // The flag is on the thread's own buffer, the binary path stays free of the shared writes
+        buffer->is_pushing.store( true, std::memory_order_seq_cst );
+        OperationStatus status{ OperationStatus::CLOSED };
+        if( !m_is_closing.load( std::memory_order_seq_cst ) )
+        {
+            status = ( ( LogOverflowPolicy::BLOCK == m_settings.overflow_policy ) && !t_is_log_writer )
+                         ? buffer->records.push( std::move( record ) )
+                         : buffer->records.try_push( std::move( record ) );
+        }
+        buffer->is_pushing.store( false, std::memory_order_release );
+
+        if( OperationStatus::UNSUCCESS == status )
+        {
+            m_dropped_count.fetch_add( 1U, std::memory_order_relaxed );
+            record.decoder( nullptr, record.payload );
+        }
+        return OperationStatus::CLOSED != status;
+    }
+
+    /// Rejects the new records and waits for the pushes in progress,
+    /// so everything accepted is written by the thread before it ends
+    void
+    close( )
+    {
+        m_is_closing.store( true, std::memory_order_seq_cst );
+        m_records.close( );
+
+        std::lock_guard< std::mutex > lock( m_buffers_mutex );
+        m_is_closed = true;
+        for( const auto& buffer : m_buffers )
+        {
+            buffer->records.close( );
+        }
+
+        // The blocked pushers are woken up by the close, the rest only finish their copy
+        while( m_pusher_count.load( std::memory_order_acquire ) > 0U )
+        {
+            std::this_thread::yield( );
+        }
+        for( const auto& buffer : m_buffers )
+        {
+            while( buffer->is_pushing.load( std::memory_order_acquire ) )
+            {
+                std::this_thread::yield( );
+            }
+        }
+    }
+
+    /// Writes out everything buffered by the calling thread
+    void
+    flush( )
+    {
+        std::lock_guard< std::mutex > lock( m_ostream_mutex );
+        while( write_batch( m_flush_batch ) )
+        {
+        }
+        m_sink.load( std::memory_order_acquire )->flush( );
+    }
+
+    uint64_t
+    get_dropped_count( ) const
+    {
+        return m_dropped_count.load( std::memory_order_relaxed );
+    }
+
+protected:
+    void
+    run( ) override
+    {
+        t_is_log_writer = true;
+
+        const auto flush_interval = std::chrono::milliseconds( m_settings.flush_interval_ms );
+        auto flush_time = Clock::now( ) + flush_interval;
+        bool is_dirty{ false };  //< Written but not flushed
+
+        while( true )
+        {
+            const uint64_t epoch = m_signal.prepare_wait( );
+            if( write( ) )
+            {
+                m_signal.cancel_wait( );
+                const auto now = Clock::now( );
+                if( !is_dirty )
+                {
+                    is_dirty = true;
+                    flush_time = now + flush_interval;
+                }
+                if( now >= flush_time )
+                {
+                    flush_stream( );
+                    is_dirty = false;
+                }
+                continue;
+            }
+
+            if( m_is_stopping.load( std::memory_order_acquire ) )
+            {
+                m_signal.cancel_wait( );
+                break;
+            }
+
+            if( !is_dirty )
+            {
+                m_signal.wait( epoch );
+            }
+            else if( !m_signal.wait_until( epoch, flush_time ) )
+            {
+                flush_stream( );
+                is_dirty = false;
+            }
+        }
+
+        flush( );
+    }
+
+    void
+    on_stop( ) override
+    {
+        m_is_stopping.store( true, std::memory_order_release );
+        m_signal.notify( );
+    }
+
+private:
+    static Thread::Settings
+    make_thread_settings( )
+    {
+        Thread::Settings settings;
+        settings.name = "_log_writer";
+        settings.repeat_type = Thread::Repeat::ONCE;
+        return settings;
+    }
+
+    ThreadBuffer*
+    get_thread_buffer( )
+    {
+        if( t_is_binary_buffer_released )
+        {
+            return nullptr;
+        }
+
+        thread_local ThreadBufferHolder holder;
+        if( holder.writer_id != m_id )
+        {
+            auto buffer = std::make_shared< ThreadBuffer >( m_settings.thread_capacity );
+            buffer->records.set_signal( &m_signal );
+            {
+                std::lock_guard< std::mutex > lock( m_buffers_mutex );
+                if( m_is_closed )
+                {
+                    return nullptr;
+                }
+                m_buffers.push_back( buffer );
+            }
+
+            if( holder.buffer )
+            {
+                holder.buffer->is_orphan.store( true, std::memory_order_release );
+            }
+            holder.buffer = std::move( buffer );
+            holder.writer_id = m_id;
+        }
+        return holder.buffer.get( );
+    }
+
+    /// Formats the binary records into m_decode_stream, the stream lock is held by the caller
+    void
+    decode_binary( size_t max_size )
+    {
+        std::lock_guard< std::mutex > lock( m_buffers_mutex );
+        BinaryLogRecord record;
+        for( auto it = m_buffers.begin( ); it != m_buffers.end( ); )
+        {
+            ThreadBuffer& buffer = **it;
+            const bool is_orphan = buffer.is_orphan.load( std::memory_order_acquire );
+            while( ( static_cast< size_t >( m_decode_stream.tellp( ) ) < max_size )
+                   && ( OperationStatus::SUCCESS == buffer.records.try_pop( record ) ) )
+            {
+                write_thread( m_decode_stream, record.thread_id, record.thread_name );
+                m_decode_stream << static_cast< LogLevel >( record.level ) << " ";
+                m_decode_stream << "\"" << record.func << "\""
+                                << " ";
+                record.decoder( &m_decode_stream, record.payload );
+                m_decode_stream << '\n';
+            }
+
+            // Nothing is pushed to the orphan after the flag is set
+            it = ( is_orphan && buffer.records.empty( ) ) ? m_buffers.erase( it ) : it + 1;
+        }
+    }
+
+    bool
+    write( )
+    {
+        std::lock_guard< std::mutex > lock( m_ostream_mutex );
+        return write_batch( m_batch );
+    }
+
+    void
+    flush_stream( )
+    {
+        std::lock_guard< std::mutex > lock( m_ostream_mutex );
+        m_sink.load( std::memory_order_acquire )->flush( );
+    }
+
+    /// Collects up to batch_size bytes into one write, the stream lock is held by the caller
+    bool
+    write_batch( std::string& batch )
+    {
+        const uint64_t dropped_count = m_dropped_count.load( std::memory_order_relaxed );
+        if( dropped_count != m_reported_dropped_count )
+        {
+            batch += "\"Log\" \"WARNING\" \"Records dropped: " + std::to_string( dropped_count - m_reported_dropped_count ) + "\"\n";
+            m_reported_dropped_count = dropped_count;
+        }
+
+        std::string record;
+        while( ( batch.size( ) < m_settings.batch_size ) && ( OperationStatus::SUCCESS == m_records.try_pop( record ) ) )
+        {
+            batch += record;
+
+            // Back to the callers: the lines are reused instead of allocated per record
+            record.clear( );
+            m_spare_lines.try_push( std::move( record ) );
+        }
+
+        if( batch.size( ) < m_settings.batch_size )
+        {
+            decode_binary( m_settings.batch_size - batch.size( ) );
+            batch += m_decode_stream.str( );
+            m_decode_stream.str( std::string( ) );
+        }
+
+        if( batch.empty( ) )
+        {
+            return false;
+        }
+
+        m_sink.load( std::memory_order_acquire )->write( batch.data( ), batch.size( ) );
+        batch.clear( );
+        return true;
+    }
+
+private:
+    const AsyncSettings m_settings{};
+    const uint64_t m_id{ g_next_writer_id.fetch_add( 1U, std::memory_order_relaxed ) };
+    const std::atomic< LogSink* >& m_sink;  //< Loaded under the stream lock
+    std::mutex& m_ostream_mutex;
+
+    MpmcQueue< std::string > m_records;
+    MpmcQueue< std::string > m_spare_lines;  //< Emptied records with their capacity
+    QueueSignal m_signal{};
+    std::atomic< bool > m_is_closing{ false };
+    std::atomic< uint32_t > m_pusher_count{ 0U };
+    std::atomic< bool > m_is_stopping{ false };
+    std::atomic< uint64_t > m_dropped_count{ 0U };
+
+    std::mutex m_buffers_mutex{};
+    std::vector< std::shared_ptr< ThreadBuffer > > m_buffers{};  //< Binary buffers of the logging threads
+    bool m_is_closed{ false };
+
+    // Under the stream lock
+    std::ostringstream m_decode_stream{};
+    std::string m_batch{};
+    std::string m_flush_batch{};
+    uint64_t m_reported_dropped_count{ 0U };
+};
+
+Log::Log( )
+    : m_sink_holder{ std::make_shared< OstreamLogSink >( std::cout ) }
+{
+    m_sink.store( m_sink_holder.get( ), std::memory_order_release );
+}
+
+Log::~Log( )
+{
+    stop_async( );
+}
+
+ErrorCode
+Log::start_async( const AsyncSettings& settings )
+{
+    std::lock_guard< std::mutex > lock( m_async_mutex );
+    if( nullptr != m_async_writer.load( std::memory_order_acquire ) )
+    {
+        return ErrorCode::INTERNAL;
+    }
+
+    // A caller that loaded the previous writer before stop_async( ) might still be inside its push( )
+    if( m_writer_holder )
+    {
+        m_retired_writers.push_back( std::move( m_writer_holder ) );
+    }
+
+    m_writer_holder = std::make_unique< AsyncWriter >( settings, m_sink, m_mutex );
+    if( ErrorCode::NONE != m_writer_holder->start( ) )
+    {
+        m_writer_holder.reset( );
+        return ErrorCode::INTERNAL;
+    }
+
+    m_async_writer.store( m_writer_holder.get( ), std::memory_order_release );
+    m_is_binary.store( settings.is_binary, std::memory_order_release );
+    return ErrorCode::NONE;
+}
+
+ErrorCode
+Log::stop_async( )
+{
+    std::lock_guard< std::mutex > lock( m_async_mutex );
+    m_is_binary.store( false, std::memory_order_release );
+    AsyncWriter* writer = m_async_writer.exchange( nullptr, std::memory_order_acq_rel );
+    if( nullptr == writer )
+    {
+        return ErrorCode::NOT_FOUND;
+    }
+
+    // Late callers get CLOSED and write synchronously, the thread drains the rest before it ends
+    writer->close( );
+    writer->stop( );
+    return ErrorCode::NONE;
+}
+
+void
+Log::set_max_log_level( LogLevel level )
+{
+    for( auto& component_level : g_log_levels )
+    {
+        component_level.store( level, std::memory_order_relaxed );
+    }
+}
+
+void
+Log::set_log_level( LogComponent component, LogLevel level )
+{
+    REQUIRED( component < LogComponent::COUNT, "Unknown component" );
+    g_log_levels[ static_cast< size_t >( component ) ].store( level, std::memory_order_relaxed );
+}
+
+LogLevel
+Log::get_log_level( LogComponent component ) const
+{
+    REQUIRED( component < LogComponent::COUNT, "Unknown component", LogLevel::FATAL );
+    return g_log_levels[ static_cast< size_t >( component ) ].load( std::memory_order_relaxed );
+}
+
+bool
+Log::is_async( ) const
+{
+    return nullptr != m_async_writer.load( std::memory_order_acquire );
+}
+
+void
+Log::flush( )
+{
+    if( AsyncWriter* writer = m_async_writer.load( std::memory_order_acquire ) )
+    {
+        writer->flush( );
+    }
+
+    std::lock_guard< std::mutex > lock( m_mutex );
+    m_sink.load( std::memory_order_acquire )->flush( );
+}
+
+ErrorCode
+Log::set_sink( std::shared_ptr< LogSink > sink )
+{
+    REQUIRED( nullptr != sink, "Empty sink", ErrorCode::INVALID_PARAM );
+
+    std::lock_guard< std::mutex > lock( m_sink_mutex );
+    {
+        // The sink is used only under the stream lock: once it is swapped under it nobody holds the previous one
+        std::lock_guard< std::mutex > stream_lock( m_mutex );
+        m_sink.store( sink.get( ), std::memory_order_release );
+    }
+
+    const std::shared_ptr< LogSink > previous = std::exchange( m_sink_holder, std::move( sink ) );
+    previous->flush( );
+    return ErrorCode::NONE;
+}
+
+uint64_t
+Log::get_dropped_count( ) const
+{
+    std::lock_guard< std::mutex > lock( m_async_mutex );
+    return m_writer_holder ? m_writer_holder->get_dropped_count( ) : 0U;
+}
+
+void
+Log::write( LogLevel level, std::string& line )
+{
+    if( AsyncWriter* writer = m_async_writer.load( std::memory_order_acquire ) )
+    {
+        if( OperationStatus::CLOSED != writer->push( line ) )
+        {
+            if( LogLevel::FATAL == level )
+            {
+                writer->flush( );
+            }
+            return;
+        }
+    }
+
+    std::lock_guard< std::mutex > lock( m_mutex );
+    LogSink* sink = m_sink.load( std::memory_order_acquire );
+    sink->write( line.data( ), line.size( ) );
+
+    // The sink flushes on its own policy, a flush per record would be a system call per line
+    if( LogLevel::FATAL == level )
+    {
+        sink->flush( );
+    }
+}
+
+bool
+Log::write_binary( BinaryLogRecord& record )
+{
+    record.thread_id = std::this_thread::get_id( );
+    record.thread_name = t_thread_name;
+    AsyncWriter* writer = m_async_writer.load( std::memory_order_acquire );
+    if( ( nullptr == writer ) || !writer->push_binary( record ) )
+    {
+        return false;
+    }
+
+    if( static_cast< uint16_t >( LogLevel::FATAL ) == record.level )
+    {
+        writer->flush( );
+    }
+    return true;
+}
+
+void
+Log::write_header( std::ostream& ostream, LogLevel level, const char* func )
+{
+    Staging* staging = get_staging( );
+    if( ( nullptr != staging ) && ( staging->prefix_name == t_thread_name ) && !staging->prefix.empty( ) )
+    {
+        ostream << staging->prefix;
+    }
+    else
+    {
+        write_thread( ostream, std::this_thread::get_id( ), t_thread_name );
+    }
+    ostream << level << " ";
+    ostream << "\"" << func << "\""
+            << " ";
+}
+
+std::ostream*
+Log::begin_line( LogLevel level, const char* func )
+{
+    Staging* staging = get_staging( );
+    if( ( nullptr == staging ) || staging->is_busy )
+    {
+        return nullptr;
+    }
+
+    staging->is_busy = true;
+    if( staging->prefix.empty( ) || ( staging->prefix_name != t_thread_name ) )
+    {
+        staging->update_prefix( );
+    }
+    staging->line.clear( );
+    staging->reset_stream( );
+    write_header( staging->stream, level, func );
+    return &staging->stream;
+}
+
+void
+Log::commit_line( LogLevel level )
+{
+    Staging* staging = get_staging( );
+    write( level, staging->line );
+    staging->is_busy = false;
+}
+
 Log&
 logger( )
 {
@@ -18,5 +736,11 @@ logger( )
     return log;
 }
 
+void
+set_log_thread_name( const std::string& name )
+{
+    t_thread_name = name.empty( ) ? nullptr : intern_thread_name( name );
+}
+
 }  // namespace common
 }  // namespace uni
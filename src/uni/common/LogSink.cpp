@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/LogSink.cpp
+/// @brief Definition log sinks.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "uni/common/LogSink.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#if !defined( __WIN64__ )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace uni
+{
+namespace common
+{
+MappedFileLogSink::MappedFileLogSink( const Settings& settings )
+    : m_settings{ settings }
+{
+}
+
+MappedFileLogSink::~MappedFileLogSink( )
+{
+    unmap_file( );
+}
+
+ErrorCode
+MappedFileLogSink::open( )
+{
+    if( m_settings.path.empty( ) || ( 0U == m_settings.file_size ) )
+    {
+        return ErrorCode::INVALID_PARAM;
+    }
+
+    unmap_file( );
+    const ErrorCode result = map_file( );
+    m_is_open = ( ErrorCode::NONE == result );
+    return result;
+}
+
+void
+MappedFileLogSink::write( const char* data, size_t size )
+{
+    if( ( nullptr == m_data ) && m_is_open && ( Clock::now( ) >= m_retry_time ) )
+    {
+        // The rotation could not open the next file (the disk was full, the directory was gone), tried again
+        map_file( );
+    }
+
+    if( ( nullptr != m_data ) && ( 0U != m_settings.rotate_interval_ms ) && ( Clock::now( ) >= m_rotate_time ) )
+    {
+        rotate( );
+    }
+
+    // Lines are not split between the files unless the write is larger than the whole file
+    if( ( nullptr != m_data ) && ( size > m_settings.file_size - m_offset ) && ( size <= m_settings.file_size ) )
+    {
+        rotate( );
+    }
+
+    while( size > 0U )
+    {
+        if( nullptr == m_data )
+        {
+            m_dropped_size.fetch_add( size, std::memory_order_relaxed );
+            return;
+        }
+
+        if( m_offset == m_settings.file_size )
+        {
+            rotate( );
+            continue;
+        }
+
+        const size_t chunk = std::min( size, m_settings.file_size - m_offset );
+        std::memcpy( m_data + m_offset, data, chunk );
+        m_offset += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+}
+
+void
+MappedFileLogSink::flush( )
+{
+#if !defined( __WIN64__ )
+    if( nullptr != m_data )
+    {
+        ::msync( m_data, m_offset, MS_ASYNC );
+    }
+#endif
+}
+
+uint64_t
+MappedFileLogSink::get_dropped_size( ) const
+{
+    return m_dropped_size.load( std::memory_order_relaxed );
+}
+
+ErrorCode
+MappedFileLogSink::map_file( )
+{
+#if defined( __WIN64__ )
+    return ErrorCode::INTERNAL;
+#else
+    m_retry_time = Clock::now( ) + std::chrono::milliseconds( m_settings.retry_interval_ms );
+
+    m_file = ::open( m_settings.path.c_str( ), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644 );
+    if( m_file < 0 )
+    {
+        return ErrorCode::INTERNAL;
+    }
+
+    // Reserved up front: a write to the sparse mapping on the full disk is SIGBUS
+#if defined( __linux__ )
+    const bool is_reserved = 0 == ::posix_fallocate( m_file, 0, static_cast< off_t >( m_settings.file_size ) );
+#else
+    const bool is_reserved = 0 == ::ftruncate( m_file, static_cast< off_t >( m_settings.file_size ) );
+#endif
+    void* data = is_reserved ? ::mmap( nullptr, m_settings.file_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_file, 0 ) : MAP_FAILED;
+    if( MAP_FAILED == data )
+    {
+        ::close( m_file );
+        m_file = -1;
+        return ErrorCode::INTERNAL;
+    }
+
+    m_data = static_cast< char* >( data );
+    m_offset = 0U;
+    m_rotate_time = Clock::now( ) + std::chrono::milliseconds( m_settings.rotate_interval_ms );
+    return ErrorCode::NONE;
+#endif
+}
+
+void
+MappedFileLogSink::unmap_file( )
+{
+#if !defined( __WIN64__ )
+    if( nullptr != m_data )
+    {
+        ::munmap( m_data, m_settings.file_size );
+        m_data = nullptr;
+    }
+
+    if( m_file >= 0 )
+    {
+        // The unused reserved tail is cut off
+        [[maybe_unused]] const int result = ::ftruncate( m_file, static_cast< off_t >( m_offset ) );
+        ::close( m_file );
+        m_file = -1;
+    }
+#endif
+}
+
+void
+MappedFileLogSink::rotate( )
+{
+    unmap_file( );
+
+    const std::string& path = m_settings.path;
+    if( m_settings.max_file_count > 1U )
+    {
+        // path.<n-2> replaces the oldest path.<n-1>, path becomes path.1
+        for( size_t index = m_settings.max_file_count - 1U; index > 0U; --index )
+        {
+            const std::string from = ( 1U == index ) ? path : path + "." + std::to_string( index - 1U );
+            std::rename( from.c_str( ), ( path + "." + std::to_string( index ) ).c_str( ) );
+        }
+    }
+
+    map_file( );
+}
+
+}  // namespace common
+}  // namespace uni
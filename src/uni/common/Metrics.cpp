@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/Metrics.cpp
+/// @brief Implementation latency histogram and metrics helpers.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "uni/common/Metrics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace uni
+{
+namespace common
+{
+uint32_t
+HistogramSnapshot::get_bucket_index( uint64_t value ) noexcept
+{
+    if( value < SUB_BUCKET_COUNT )
+    {
+        return static_cast< uint32_t >( value );
+    }
+
+    // The highest bit selects the power of two, the next SUB_BUCKET_BITS bits select the sub-bucket
+    const uint32_t msb = 63U - static_cast< uint32_t >( __builtin_clzll( value ) );
+    const uint32_t sub_bucket = static_cast< uint32_t >( value >> ( msb - SUB_BUCKET_BITS ) ) & ( SUB_BUCKET_COUNT - 1U );
+    return ( msb - SUB_BUCKET_BITS + 1U ) * SUB_BUCKET_COUNT + sub_bucket;
+}
+
+uint64_t
+HistogramSnapshot::get_bucket_upper_bound( uint32_t index ) noexcept
+{
+    if( index < SUB_BUCKET_COUNT )
+    {
+        return index;
+    }
+
+    const uint32_t msb = index / SUB_BUCKET_COUNT + SUB_BUCKET_BITS - 1U;
+    const uint64_t sub_bucket = index % SUB_BUCKET_COUNT;
+    const uint64_t width = uint64_t{ 1U } << ( msb - SUB_BUCKET_BITS );
+    return ( ( SUB_BUCKET_COUNT + sub_bucket ) << ( msb - SUB_BUCKET_BITS ) ) + ( width - 1U );
+}
+
+void
+HistogramSnapshot::merge( const HistogramSnapshot& other )
+{
+    for( uint32_t i = 0U; i < BUCKET_COUNT; ++i )
+    {
+        m_buckets[ i ] += other.m_buckets[ i ];
+    }
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_max = std::max( m_max, other.m_max );
+}
+
+uint64_t
+HistogramSnapshot::get_count( ) const noexcept
+{
+    return m_count;
+}
+
+uint64_t
+HistogramSnapshot::get_max( ) const noexcept
+{
+    return m_max;
+}
+
+uint64_t
+HistogramSnapshot::get_mean( ) const noexcept
+{
+    return ( 0U == m_count ) ? 0U : m_sum / m_count;
+}
+
+uint64_t
+HistogramSnapshot::get_percentile( double quantile ) const noexcept
+{
+    if( 0U == m_count )
+    {
+        return 0U;
+    }
+
+    // The bucket counts of the snapshot may be a bit ahead of m_count, rank is taken from the buckets
+    uint64_t total{ 0U };
+    for( const auto bucket : m_buckets )
+    {
+        total += bucket;
+    }
+
+    const auto rank = std::max< uint64_t >( 1U, static_cast< uint64_t >( std::ceil( std::clamp( quantile, 0.0, 1.0 ) * total ) ) );
+    uint64_t seen{ 0U };
+    for( uint32_t i = 0U; i < BUCKET_COUNT; ++i )
+    {
+        seen += m_buckets[ i ];
+        if( seen >= rank )
+        {
+            return std::min( get_bucket_upper_bound( i ), m_max );
+        }
+    }
+    return m_max;
+}
+
+LatencySummary
+HistogramSnapshot::summarize( ) const
+{
+    return LatencySummary{ m_count, get_mean( ), get_percentile( 0.5 ), get_percentile( 0.9 ), get_percentile( 0.99 ), m_max };
+}
+
+HistogramSnapshot
+LatencyHistogram::snapshot( ) const
+{
+    HistogramSnapshot snapshot;
+    for( uint32_t i = 0U; i < HistogramSnapshot::BUCKET_COUNT; ++i )
+    {
+        snapshot.m_buckets[ i ] = m_buckets[ i ].load( std::memory_order_relaxed );
+    }
+    snapshot.m_count = m_count.load( std::memory_order_relaxed );
+    snapshot.m_sum = m_sum.load( std::memory_order_relaxed );
+    snapshot.m_max = m_max.load( std::memory_order_relaxed );
+    return snapshot;
+}
+
+}  // namespace common
+}  // namespace uni
@@ -5,6 +5,8 @@
 /// @date 23.08.2020
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#define UNI_LOG_COMPONENT ::uni::common::LogComponent::THREAD
+
 #include <uni/common/Log.hpp>
 #include <uni/common/Thread.hpp>
 
@@ -132,6 +134,8 @@ Thread::get_name( ) const
 void
 set_current_thread_name( const std::string& name )
 {
+    set_log_thread_name( name );
+
 #if defined( __APPLE__ )
     pthread_setname_np( name.c_str( ) );
 #elif defined( __linux__ )
@@ -158,6 +162,11 @@ Thread::prepare_and_run( )
 
     set_current_thread_name( m_settings.name );
 
+    if( !m_settings.cpu_affinity.empty( ) && ( ErrorCode::NONE != set_current_thread_affinity( m_settings.cpu_affinity ) ) )
+    {
+        LOG_WARNING_MSG( "Thread affinity was not set: ", m_settings.cpu_affinity );
+    }
+
     switch( m_settings.repeat_type )
     {
         case( Repeat::ONCE ):
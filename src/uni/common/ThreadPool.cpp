@@ -5,88 +5,1105 @@
 /// @date 2020-2021
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#define UNI_LOG_COMPONENT ::uni::common::LogComponent::POOL
+
 #include "uni/common/ThreadPool.hpp"
+#include "uni/common/Backoff.hpp"
 #include "uni/common/Log.hpp"
 #include "uni/common/Queue.hpp"
 
+#include <algorithm>
+
 namespace uni
 {
 namespace common
 {
 namespace
 {
-class TaskRunner : public uni::common::Thread
+// Identifies the pool and the worker of the current thread, used to route nested submits
+thread_local const ThreadPool* t_current_pool{ nullptr };
+thread_local uint32_t t_current_worker{ 0U };
+
+/// CPU sets of the workers for the placement policy, empty vector means no placement
+std::vector< CpuSet >
+make_worker_affinity( const ThreadPool::PlacementSettings& placement, uint32_t worker_count )
+{
+    using Placement = ThreadPool::Placement;
+
+    if( Placement::NONE == placement.policy )
+    {
+        return { };
+    }
+
+    if( Placement::NUMA_NODE == placement.policy )
+    {
+        const CpuSet node_cpus = get_numa_node_cpus( placement.numa_node );
+        REQUIRED( !node_cpus.empty( ), "Unknown NUMA node", std::vector< CpuSet >{ } );
+        return std::vector< CpuSet >( worker_count, node_cpus );
+    }
+
+    // Topology is sorted by node, package, core, so the siblings of the core are adjacent
+    const auto topology = get_cpu_topology( );
+
+    // Logical CPUs grouped by the package, then by the physical core
+    std::vector< std::vector< std::vector< uint32_t > > > packages;
+    for( size_t i = 0U; i < topology.size( ); ++i )
+    {
+        const bool is_new_package
+            = ( i == 0U ) || ( topology[ i ].node != topology[ i - 1U ].node ) || ( topology[ i ].package != topology[ i - 1U ].package );
+        if( is_new_package )
+        {
+            packages.emplace_back( );
+        }
+
+        if( is_new_package || ( topology[ i ].core != topology[ i - 1U ].core ) )
+        {
+            packages.back( ).emplace_back( );
+        }
+        packages.back( ).back( ).push_back( topology[ i ].cpu );
+    }
+
+    std::vector< uint32_t > order;
+    switch( placement.policy )
+    {
+        case( Placement::COMPACT ):
+        {
+            for( const auto& info : topology )
+            {
+                order.push_back( info.cpu );
+            }
+        }
+        break;
+
+        case( Placement::PHYSICAL_CORES ):
+        {
+            for( const auto& cores : packages )
+            {
+                for( const auto& siblings : cores )
+                {
+                    order.push_back( siblings.front( ) );
+                }
+            }
+        }
+        break;
+
+        case( Placement::SCATTER ):
+        {
+            // Sibling index, then core index, then package: neighbour workers land on different packages
+            for( size_t sibling = 0U; order.size( ) < topology.size( ); ++sibling )
+            {
+                for( size_t core = 0U;; ++core )
+                {
+                    bool has_core{ false };
+                    for( const auto& cores : packages )
+                    {
+                        if( core < cores.size( ) )
+                        {
+                            has_core = true;
+                            if( sibling < cores[ core ].size( ) )
+                            {
+                                order.push_back( cores[ core ][ sibling ] );
+                            }
+                        }
+                    }
+
+                    if( !has_core )
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+        break;
+
+        default:
+            break;
+    }
+
+    std::vector< CpuSet > affinity;
+    for( uint32_t i = 0U; ( i < worker_count ) && !order.empty( ); ++i )
+    {
+        affinity.push_back( CpuSet{ order[ i % order.size( ) ] } );
+    }
+    return affinity;
+}
+
+uint64_t
+next_random( uint64_t& state )
+{
+    // xorshift64
+    state ^= state << 13U;
+    state ^= state >> 7U;
+    state ^= state << 17U;
+    return state;
+}
+}  // namespace
+
+
+class ThreadPool::TaskRunner : public uni::common::Thread
 {
 public:
-    TaskRunner( const Thread::Settings& settings, Queue< DefaultVoidStdFunction >& queue )
+    TaskRunner( const Thread::Settings& settings, ThreadPool& pool, uint32_t index )
         : Thread( settings )
-        , m_queue{ queue }
+        , m_pool{ pool }
+        , m_index{ index }
+        , m_is_pinned{ !settings.cpu_affinity.empty( ) }
+        , m_random_state{ 0x9E3779B97F4A7C15ULL * ( index + 1U ) }
+    {
+    }
+
+    WorkStealingDeque< LaneTask* >&
+    local_queue( )
+    {
+        return m_local_queue;
+    }
+
+    uint32_t
+    random_victim( uint32_t count )
+    {
+        return static_cast< uint32_t >( next_random( m_random_state ) % count );
+    }
+
+    uint32_t
+    get_index( ) const
+    {
+        return m_index;
+    }
+
+    bool
+    is_stopping( ) const
+    {
+        return m_is_stopping.load( std::memory_order_acquire ) || m_pool.m_is_stopped.load( std::memory_order_acquire );
+    }
+
+    bool
+    is_active( ) const
+    {
+        return m_is_active.load( std::memory_order_acquire );
+    }
+
+    void
+    set_active( bool is_active )
+    {
+        m_is_active.store( is_active, std::memory_order_release );
+    }
+
+    uint64_t
+    get_executed_count( ) const
+    {
+        return m_executed_count.load( std::memory_order_relaxed );
+    }
+
+    void
+    execute( LaneTask& task )
+    {
+        if( !m_pool.m_settings.enable_metrics )
+        {
+            task.task( );
+            m_pool.finish_task( );
+            return;
+        }
+
+        const auto start_time = Clock::now( );
+        task.task( );
+        const auto end_time = Clock::now( );
+
+        const auto to_ns = []( Clock::duration duration ) {
+            return static_cast< uint64_t >( std::chrono::duration_cast< std::chrono::nanoseconds >( duration ).count( ) );
+        };
+        m_wait_time.record( to_ns( start_time - task.enqueue_time ) );
+        m_run_time.record( to_ns( end_time - start_time ) );
+        m_busy_ns.store( m_busy_ns.load( std::memory_order_relaxed ) + to_ns( end_time - start_time ), std::memory_order_relaxed );
+        m_pool.finish_task( );
+    }
+
+    WorkerMetrics
+    get_metrics( Clock::duration uptime ) const
     {
+        const auto uptime_ns = std::chrono::duration_cast< std::chrono::nanoseconds >( uptime ).count( );
+
+        WorkerMetrics metrics;
+        metrics.index = m_index;
+        metrics.is_active = is_active( );
+        metrics.executed_count = get_executed_count( );
+        metrics.busy_ratio = ( uptime_ns > 0 ) ? static_cast< double >( m_busy_ns.load( std::memory_order_relaxed ) ) / uptime_ns : 0.0;
+        metrics.wait_time = m_wait_time.snapshot( );
+        metrics.run_time = m_run_time.snapshot( );
+        return metrics;
     }
 
+protected:
     void
     run( ) override
     {
-        DefaultVoidStdFunction task;
-        if( OperationStatus::SUCCESS == m_queue.try_pop( task ) )
+        t_current_pool = &m_pool;
+        t_current_worker = m_index;
+
+        if( m_is_pinned && !m_is_relocated )
         {
-            task( );
+            // The thread is already on its CPU, move the deque storage to the local NUMA node.
+            // The slot keeps its CPU across the elastic restarts, once is enough: the replaced array is never freed
+            m_local_queue.relocate( );
+            m_is_relocated = true;
         }
-        else
+
+        const IdleSettings& idle = m_pool.m_settings.idle;
+        const auto keep_alive = std::chrono::milliseconds( m_pool.m_settings.elastic.keep_alive_ms );
+        Backoff backoff{ idle.spin_count, idle.yield_count };
+        bool is_idle{ false };
+        std::chrono::steady_clock::time_point idle_since{};
+
+        while( !is_stopping( ) )
         {
-            // Could be sleeped for ~50MS
-            std::this_thread::yield( );
+            if( m_pool.run_next_task( *this ) )
+            {
+                // Only the owner writes, no need in the locked increment
+                m_executed_count.store( m_executed_count.load( std::memory_order_relaxed ) + 1U, std::memory_order_relaxed );
+                backoff.reset( );
+                is_idle = false;
+                continue;
+            }
+
+            switch( idle.strategy )
+            {
+                case( IdleStrategy::SPIN ):
+                {
+                    cpu_relax( );
+                }
+                break;
+
+                case( IdleStrategy::YIELD ):
+                {
+                    if( !backoff.pause( ) )
+                    {
+                        std::this_thread::yield( );
+                    }
+                }
+                break;
+
+                case( IdleStrategy::PARK ):
+                {
+                    if( backoff.pause( ) )
+                    {
+                        break;
+                    }
+
+                    if( m_pool.is_elastic( ) && !is_idle )
+                    {
+                        is_idle = true;
+                        idle_since = std::chrono::steady_clock::now( );
+                    }
+
+                    m_pool.park( *this );
+                    backoff.reset( );
+
+                    if( is_idle && ( std::chrono::steady_clock::now( ) - idle_since >= keep_alive ) && m_pool.try_retire( ) )
+                    {
+                        LOG_DEBUG_MSG( "Worker retired: ", get_name( ) );
+                        t_current_pool = nullptr;
+                        set_active( false );
+                        return;
+                    }
+                }
+                break;
+            }
         }
+
+        t_current_pool = nullptr;
+        set_active( false );
+    }
+
+    void
+    on_start( ) override
+    {
+        m_is_stopping.store( false, std::memory_order_release );
+    }
+
+    void
+    on_stop( ) override
+    {
+        m_is_stopping.store( true, std::memory_order_release );
+        m_pool.wake_all( );
     }
 
 private:
-    Queue< DefaultVoidStdFunction >& m_queue;
+    ThreadPool& m_pool;
+    const uint32_t m_index{ 0U };
+    const bool m_is_pinned{ false };
+    bool m_is_relocated{ false };  //< Worker thread only, the restarts are joined in between
+    uint64_t m_random_state{ 0U };
+    std::atomic< bool > m_is_stopping{ false };
+    std::atomic< bool > m_is_active{ false };
+    std::atomic< uint64_t > m_executed_count{ 0U };
+    WorkStealingDeque< LaneTask* > m_local_queue{};
+
+    // Written by the worker only, read by get_metrics( )
+    LatencyHistogram m_wait_time{};
+    LatencyHistogram m_run_time{};
+    std::atomic< uint64_t > m_busy_ns{ 0U };
+};
+
+
+class ThreadPool::Supervisor : public uni::common::Thread
+{
+public:
+    Supervisor( const Thread::Settings& settings, ThreadPool& pool )
+        : Thread( settings )
+        , m_pool{ pool }
+    {
+    }
+
+protected:
+    void
+    run( ) override
+    {
+        m_pool.adjust_size( );
+    }
+
+private:
+    ThreadPool& m_pool;
+};
+
+
+/// The one timer thread of the pool, fires the due timers into the lanes
+class ThreadPool::TimerRunner : public uni::common::Thread
+{
+public:
+    TimerRunner( const Thread::Settings& settings, ThreadPool& pool )
+        : Thread( settings )
+        , m_pool{ pool }
+    {
+    }
+
+    bool
+    is_stopping( ) const
+    {
+        return m_is_stopping.load( std::memory_order_acquire );
+    }
+
+protected:
+    void
+    run( ) override
+    {
+        m_pool.run_timers( *this );
+    }
+
+    void
+    on_start( ) override
+    {
+        m_is_stopping.store( false, std::memory_order_release );
+    }
+
+    void
+    on_stop( ) override
+    {
+        m_is_stopping.store( true, std::memory_order_release );
+        m_pool.wake_timers( );
+    }
+
+private:
+    ThreadPool& m_pool;
+    std::atomic< bool > m_is_stopping{ false };
 };
-}  // namespace
 
 
 ThreadPool::ThreadPool( const Settings& settings )
+    : m_settings{ settings }
+    , m_timer_wheel{ std::chrono::milliseconds( settings.timer_resolution_ms ) }
 {
     LOG_DEBUG_MSG( LOG_IT( settings ) );
 
-    for( uint32_t i = 0; i < settings.thread_count; ++i )
+    for( auto& lane : m_lanes )
+    {
+        lane.queue.set_metrics_enabled( settings.enable_metrics );
+    }
+
+    const uint32_t initial_count = settings.thread_count;
+    uint32_t max_count = initial_count;
+    m_min_thread_count = initial_count;
+    if( is_elastic( ) )
+    {
+        max_count = std::max( settings.elastic.max_thread_count, initial_count );
+        m_min_thread_count = std::max( 1U, std::min( settings.elastic.min_thread_count, initial_count ) );
+    }
+
+    const auto worker_affinity = make_worker_affinity( settings.placement, max_count );
+
+    for( uint32_t i = 0; i < max_count; ++i )
+    {
+        Thread::Settings thread_settings{ settings.thread_settings };
+        thread_settings.name = settings.thread_settings.name + "_" + std::to_string( i );
+        thread_settings.repeat_type = Thread::Repeat::ONCE;
+        if( i < worker_affinity.size( ) )
+        {
+            thread_settings.cpu_affinity = worker_affinity[ i ];
+        }
+
+        m_threads.emplace_back( std::make_unique< TaskRunner >( thread_settings, *this, i ) );
+    }
+
+    // Start only when all the deques exist, because workers steal from each other
+    for( uint32_t i = 0; i < initial_count; ++i )
+    {
+        start_worker( );
+    }
+
+    if( is_elastic( ) )
     {
-        const std::string thread_name = settings.thread_settings.name + "_" + std::to_string( i );
-        Thread::Settings settings{ { thread_name } };
+        Thread::Settings supervisor_settings{ settings.thread_settings };
+        supervisor_settings.name = settings.thread_settings.name + "_supervisor";
+        supervisor_settings.repeat_type = Thread::Repeat::LOOP;
+        supervisor_settings.timeout_ms = settings.elastic.check_interval_ms;
 
-        m_threads.emplace_back( std::make_unique< TaskRunner >( settings, m_queue ) );
+        m_last_progress_time = std::chrono::steady_clock::now( );
+        m_supervisor = std::make_unique< Supervisor >( supervisor_settings, *this );
+        m_supervisor->start( );
     }
 }
 
 ThreadPool::~ThreadPool( )
 {
     LOG_TRACE_MSG( "" );
+
+    if( !m_is_shut_down )
+    {
+        const ShutdownStats stats = shutdown( ShutdownMode::CANCEL );
+        if( stats.dropped_count > 0U )
+        {
+            LOG_WARNING_MSG( "Queued tasks were dropped by the destructor: ", stats.dropped_count );
+        }
+    }
+}
+
+ThreadPool::ShutdownStats
+ThreadPool::shutdown( ShutdownMode mode, Clock::duration timeout )
+{
+    LOG_DEBUG_MSG( LOG_IT( mode ) );
+
+    REQUIRED( this != t_current_pool, "Thread pool can not be shut down from its worker", ShutdownStats{ } );
+    REQUIRED( !m_is_shut_down.exchange( true ), "Thread pool is already shut down", ShutdownStats{ } );
+
+    m_is_draining = ( ShutdownMode::CANCEL != mode );
     m_is_on_shutdown = true;
 
+    {
+        // Timers are not submitted after the shutdown flag is set, no new runner can appear
+        std::lock_guard< std::mutex > lock( m_timer_mutex );
+    }
+    if( m_timer_runner )
+    {
+        m_timer_runner->stop( );
+    }
+
+    // Pending timers never fire, they are destroyed outside the lock: a dropped coroutine resume continues the coroutine
+    std::vector< Task > dropped_timer_tasks;
+    {
+        std::lock_guard< std::mutex > lock( m_timer_mutex );
+        m_timer_wheel.clear( [ this ]( Task&& task ) { m_dropped_timer_tasks.push_back( std::move( task ) ); } );
+        dropped_timer_tasks.swap( m_dropped_timer_tasks );
+    }
+    dropped_timer_tasks.clear( );
+
+    if( m_supervisor )
+    {
+        m_supervisor->stop( );
+    }
+
+    ShutdownStats stats;
+    switch( mode )
+    {
+        case( ShutdownMode::DRAIN ):
+        {
+            wait_idle( );
+        }
+        break;
+
+        case( ShutdownMode::TIMEOUT ):
+        {
+            stats.is_timed_out = ( ErrorCode::TIMEOUT == wait_idle( timeout ) );
+        }
+        break;
+
+        case( ShutdownMode::CANCEL ):
+            break;
+    }
+    m_is_draining = false;
+
+    // Every worker is told to stop before any of them is joined, the queued tasks are not started any more
+    m_is_stopped.store( true, std::memory_order_release );
+    for( auto& lane : m_lanes )
+    {
+        lane.queue.close( );
+    }
+    wake_all( );
+
     for( auto& thread : m_threads )
     {
-        if( thread )
+        if( !thread )
+        {
+            LOG_ERROR_MSG( "Empty thread" );
+        }
+        else if( thread->is_running( ) )
         {
             thread->stop( );
         }
-        else
+    }
+
+    // Workers are joined, what is left in the queues never runs
+    for( auto& lane : m_lanes )
+    {
+        LaneTask task;
+        while( OperationStatus::SUCCESS == lane.queue.try_pop( task ) )
         {
-            LOG_ERROR_MSG( "Empty thread" );
+            task.task.reset( );
+            m_dropped_count.fetch_add( 1U, std::memory_order_relaxed );
+            finish_task( );
+        }
+    }
+
+    for( auto& thread : m_threads )
+    {
+        LaneTask* task{ nullptr };
+        while( thread->local_queue( ).pop( task ) )
+        {
+            recycled_delete( task );
+            m_dropped_count.fetch_add( 1U, std::memory_order_relaxed );
+            finish_task( );
         }
     }
+
+    for( const auto& thread : m_threads )
+    {
+        stats.completed_count += thread->get_executed_count( );
+    }
+    stats.dropped_count = m_dropped_count.load( std::memory_order_relaxed );
+    stats.expired_count = get_expired_count( );
+
+    LOG_DEBUG_MSG( LOG_IT( stats ) );
+    return stats;
 }
 
 ErrorCode
-ThreadPool::submit( const DefaultVoidStdFunction& task )
+ThreadPool::wait_idle( Clock::duration timeout )
 {
-    REQUIRED( !m_is_on_shutdown, "Thread pool is on shutdown", ErrorCode::INTERNAL );
+    REQUIRED( this != t_current_pool, "Waiting for the idle pool from its worker never ends", ErrorCode::INTERNAL );
+
+    const auto is_idle = [ this ] { return 0U == m_outstanding_count.load( std::memory_order_acquire ); };
+
+    std::unique_lock< std::mutex > lock( m_idle_mutex );
+    if( Clock::duration::max( ) == timeout )
+    {
+        m_idle_cv.wait( lock, is_idle );
+        return ErrorCode::NONE;
+    }
 
+    return m_idle_cv.wait_for( lock, timeout, is_idle ) ? ErrorCode::NONE : ErrorCode::TIMEOUT;
+}
+
+ErrorCode
+ThreadPool::submit( const DefaultVoidStdFunction& task )
+{
     LOG_TRACE_MSG( "" );
 
-    m_queue.push( task );
+    return push_task( Task{ task }, Priority::NORMAL, Clock::time_point::max( ) );
+}
+
+ErrorCode
+ThreadPool::submit( const DefaultVoidStdFunction& task, Priority priority, Clock::time_point deadline )
+{
+    LOG_TRACE_MSG( LOG_IT( priority ) );
+
+    return push_task( Task{ task }, priority, deadline );
+}
+
+uint32_t
+ThreadPool::get_thread_count( ) const
+{
+    return m_active_count.load( std::memory_order_relaxed );
+}
+
+uint64_t
+ThreadPool::get_expired_count( ) const
+{
+    return m_expired_count.load( std::memory_order_relaxed );
+}
+
+ThreadPool::Metrics
+ThreadPool::get_metrics( ) const
+{
+    const auto uptime = Clock::now( ) - m_start_time;
+
+    Metrics metrics;
+    metrics.uptime_ms = static_cast< uint64_t >( std::chrono::duration_cast< std::chrono::milliseconds >( uptime ).count( ) );
+    metrics.thread_count = get_thread_count( );
+    metrics.expired_count = get_expired_count( );
+    metrics.high_lane = m_lanes[ static_cast< size_t >( Priority::HIGH ) ].queue.get_metrics( );
+    metrics.normal_lane = m_lanes[ static_cast< size_t >( Priority::NORMAL ) ].queue.get_metrics( );
+    metrics.low_lane = m_lanes[ static_cast< size_t >( Priority::LOW ) ].queue.get_metrics( );
+
+    for( const auto& thread : m_threads )
+    {
+        metrics.workers.push_back( thread->get_metrics( uptime ) );
+
+        const WorkerMetrics& worker = metrics.workers.back( );
+        metrics.executed_count += worker.executed_count;
+        metrics.local_queue_depth += thread->local_queue( ).size( );
+        metrics.wait_time.merge( worker.wait_time );
+        metrics.run_time.merge( worker.run_time );
+    }
+
+    return metrics;
+}
+
+ErrorCode
+ThreadPool::cancel( const TimerHandle& handle )
+{
+    LOG_TRACE_MSG( LOG_IT( handle ) );
+
+    std::lock_guard< std::mutex > lock( m_timer_mutex );
+    return m_timer_wheel.cancel( handle ) ? ErrorCode::NONE : ErrorCode::NOT_FOUND;
+}
+
+ThreadPool::TimerHandle
+ThreadPool::add_timer( Clock::time_point due, Clock::duration period, Task&& task )
+{
+    std::lock_guard< std::mutex > lock( m_timer_mutex );
+    REQUIRED( !m_is_on_shutdown, "Thread pool is on shutdown", TimerHandle{ } );
+
+    if( !m_timer_runner )
+    {
+        Thread::Settings thread_settings{ m_settings.thread_settings };
+        thread_settings.name = m_settings.thread_settings.name + "_timer";
+        thread_settings.repeat_type = Thread::Repeat::ONCE;
+        m_timer_runner = std::make_unique< TimerRunner >( thread_settings, *this );
+        m_timer_runner->start( );
+    }
+
+    const TimerHandle handle = m_timer_wheel.add( due, period, std::move( task ) );
+
+    // The timer thread sleeps until the next tick with timers, wake it only for an earlier one
+    if( due < m_timer_wake_time )
+    {
+        m_timer_wake_time = due;
+        m_timer_cv.notify_one( );
+    }
+
+    return handle;
+}
+
+void
+ThreadPool::run_timers( const TimerRunner& runner )
+{
+    // Dropping a task may continue a coroutine, which must not run under the timer lock
+    const auto on_due = [ this ]( Task&& task ) {
+        if( m_is_on_shutdown || ( ErrorCode::NONE != push_task( std::move( task ), Priority::NORMAL, Clock::time_point::max( ) ) ) )
+        {
+            m_dropped_timer_tasks.push_back( std::move( task ) );
+        }
+    };
+
+    std::unique_lock< std::mutex > lock( m_timer_mutex );
+    while( !runner.is_stopping( ) )
+    {
+        m_timer_wheel.advance( Clock::now( ), on_due );
+
+        m_timer_wake_time = m_timer_wheel.get_next_expiry( );
+        if( Clock::time_point::max( ) == m_timer_wake_time )
+        {
+            m_timer_cv.wait( lock );
+        }
+        else
+        {
+            m_timer_cv.wait_until( lock, m_timer_wake_time );
+        }
+    }
+}
+
+void
+ThreadPool::wake_timers( )
+{
+    std::lock_guard< std::mutex > lock( m_timer_mutex );
+    m_timer_cv.notify_one( );
+}
+
+bool
+ThreadPool::is_accepting_tasks( ) const
+{
+    return !m_is_on_shutdown || ( m_is_draining && ( this == t_current_pool ) );
+}
+
+ErrorCode
+ThreadPool::push_task( Task&& task, Priority priority, Clock::time_point deadline )
+{
+    REQUIRED( is_accepting_tasks( ), "Thread pool is on shutdown", ErrorCode::INTERNAL );
+    REQUIRED( priority < Priority::COUNT, "Invalid priority", ErrorCode::INVALID_PARAM );
+
+    // Counted before the task becomes visible, so a worker never finishes it before the increment
+    m_outstanding_count.fetch_add( 1U, std::memory_order_relaxed );
+
+    const Clock::time_point enqueue_time = m_settings.enable_metrics ? Clock::now( ) : Clock::time_point{ };
+
+    // Only plain tasks go to the local deque, it knows nothing about priorities and deadlines
+    const bool is_plain_task = ( Priority::NORMAL == priority ) && ( Clock::time_point::max( ) == deadline );
+
+    if( is_plain_task && ( Scheduling::WORK_STEALING == m_settings.scheduling ) && ( this == t_current_pool ) )
+    {
+        m_threads[ t_current_worker ]->local_queue( ).push( recycled_new< LaneTask >( LaneTask{ std::move( task ), deadline, enqueue_time } ) );
+    }
+    else
+    {
+        Lane& lane = m_lanes[ static_cast< size_t >( priority ) ];
+
+        // Counted before the push, so the pop never sees the counter below the queue size
+        if( 0U == lane.pending_count.fetch_add( 1U, std::memory_order_acq_rel ) )
+        {
+            lane.waiting_since.store( Clock::now( ).time_since_epoch( ).count( ), std::memory_order_relaxed );
+        }
+        LaneTask lane_task{ std::move( task ), deadline, enqueue_time };
+        if( OperationStatus::SUCCESS != lane.queue.push( std::move( lane_task ) ) )
+        {
+            // The shutdown closed the lanes after the check above, the closed queue does not take the task
+            task = std::move( lane_task.task );
+            lane.pending_count.fetch_sub( 1U, std::memory_order_acq_rel );
+            finish_task( );
+            LOG_DEBUG_MSG( "Thread pool is on shutdown, task is dropped" );
+            return ErrorCode::INTERNAL;
+        }
+    }
+
+    // Pairs with the fence in park( ): either the worker sees the task or we see the parked worker
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    if( m_parked_count.load( std::memory_order_relaxed ) > 0U )
+    {
+        wake_one( );
+    }
 
     return ErrorCode::NONE;
 }
 
+bool
+ThreadPool::run_next_task( TaskRunner& runner )
+{
+    if( m_is_stopped.load( std::memory_order_acquire ) )
+    {
+        return false;
+    }
+
+    const bool is_work_stealing = ( Scheduling::WORK_STEALING == m_settings.scheduling );
+
+    // Order: starving lower lanes, HIGH lane, local deque, NORMAL lane, stealing, LOW lane
+    LaneTask task;
+    if( pop_starving_lane_task( task ) || pop_lane_task( Priority::HIGH, task ) )
+    {
+        runner.execute( task );
+        return true;
+    }
+
+    LaneTask* local_task{ nullptr };
+    if( is_work_stealing && runner.local_queue( ).pop( local_task ) )
+    {
+        runner.execute( *local_task );
+        recycled_delete( local_task );
+        return true;
+    }
+
+    if( pop_lane_task( Priority::NORMAL, task ) )
+    {
+        runner.execute( task );
+        return true;
+    }
+
+    if( is_work_stealing && steal_task( runner, local_task ) )
+    {
+        runner.execute( *local_task );
+        recycled_delete( local_task );
+        return true;
+    }
+
+    if( pop_lane_task( Priority::LOW, task ) )
+    {
+        runner.execute( task );
+        return true;
+    }
+
+    return false;
+}
+
+bool
+ThreadPool::pop_lane_task( Priority priority, LaneTask& lane_task )
+{
+    Lane& lane = m_lanes[ static_cast< size_t >( priority ) ];
+
+    while( lane.pending_count.load( std::memory_order_acquire ) > 0U )
+    {
+        if( OperationStatus::SUCCESS != lane.queue.try_pop( lane_task ) )
+        {
+            return false;
+        }
+
+        const bool has_deadline = ( Clock::time_point::max( ) != lane_task.deadline );
+        const auto now = has_deadline ? Clock::now( ) : Clock::time_point{ };
+
+        if( ( lane.pending_count.fetch_sub( 1U, std::memory_order_acq_rel ) > 1U ) && ( 0U != m_settings.priority_aging_ms ) )
+        {
+            // The next task waits at least since now
+            lane.waiting_since.store( ( has_deadline ? now : Clock::now( ) ).time_since_epoch( ).count( ), std::memory_order_relaxed );
+        }
+
+        if( has_deadline && ( now > lane_task.deadline ) )
+        {
+            // Dropped task breaks its promise
+            m_expired_count.fetch_add( 1U, std::memory_order_relaxed );
+            LOG_DEBUG_MSG( "Task missed the deadline, dropped. Priority: ", priority );
+            lane_task.task.reset( );
+            finish_task( );
+            continue;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+bool
+ThreadPool::pop_starving_lane_task( LaneTask& task )
+{
+    if( 0U == m_settings.priority_aging_ms )
+    {
+        return false;
+    }
+
+    const auto aging = std::chrono::duration_cast< Clock::duration >( std::chrono::milliseconds( m_settings.priority_aging_ms ) ).count( );
+    Clock::rep now{ 0 };
+
+    // The lowest lane is the most likely to starve
+    for( size_t i = static_cast< size_t >( Priority::COUNT ) - 1U; i > static_cast< size_t >( Priority::HIGH ); --i )
+    {
+        const Lane& lane = m_lanes[ i ];
+        if( 0U == lane.pending_count.load( std::memory_order_relaxed ) )
+        {
+            continue;
+        }
+
+        if( 0 == now )
+        {
+            now = Clock::now( ).time_since_epoch( ).count( );
+        }
+
+        if( ( now - lane.waiting_since.load( std::memory_order_relaxed ) >= aging ) && pop_lane_task( static_cast< Priority >( i ), task ) )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void
+ThreadPool::finish_task( )
+{
+    if( 1U == m_outstanding_count.fetch_sub( 1U, std::memory_order_acq_rel ) )
+    {
+        std::lock_guard< std::mutex > lock( m_idle_mutex );
+        m_idle_cv.notify_all( );
+    }
+}
+
+bool
+ThreadPool::has_pending_tasks( ) const
+{
+    for( const auto& lane : m_lanes )
+    {
+        if( lane.pending_count.load( std::memory_order_relaxed ) > 0U )
+        {
+            return true;
+        }
+    }
+
+    if( Scheduling::WORK_STEALING == m_settings.scheduling )
+    {
+        for( const auto& thread : m_threads )
+        {
+            if( !thread->local_queue( ).empty( ) )
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void
+ThreadPool::park( const TaskRunner& runner )
+{
+    m_parked_count.fetch_add( 1U, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+
+    // The task might be pushed right before the worker was counted as parked
+    if( !has_pending_tasks( ) )
+    {
+        std::unique_lock< std::mutex > lock( m_park_mutex );
+        m_park_cv.wait_for( lock, std::chrono::milliseconds( m_settings.idle.park_timeout_ms ), [ this, &runner ] {
+            return ( m_wakeup_count > 0U ) || runner.is_stopping( );
+        } );
+
+        if( m_wakeup_count > 0U )
+        {
+            --m_wakeup_count;
+        }
+    }
+
+    m_parked_count.fetch_sub( 1U, std::memory_order_relaxed );
+}
+
+void
+ThreadPool::wake_one( )
+{
+    {
+        std::lock_guard< std::mutex > lock( m_park_mutex );
+        if( m_wakeup_count >= m_parked_count.load( std::memory_order_relaxed ) )
+        {
+            // Every parked worker is already woken up
+            return;
+        }
+        ++m_wakeup_count;
+    }
+    m_park_cv.notify_one( );
+}
+
+void
+ThreadPool::wake_all( )
+{
+    std::lock_guard< std::mutex > lock( m_park_mutex );
+    m_park_cv.notify_all( );
+}
+
+bool
+ThreadPool::is_elastic( ) const
+{
+    return m_settings.elastic.max_thread_count != 0U;
+}
+
+size_t
+ThreadPool::get_pending_task_count( ) const
+{
+    size_t count{ 0U };
+    for( const auto& lane : m_lanes )
+    {
+        count += lane.pending_count.load( std::memory_order_relaxed );
+    }
+
+    for( const auto& thread : m_threads )
+    {
+        count += thread->local_queue( ).size( );
+    }
+    return count;
+}
+
+void
+ThreadPool::adjust_size( )
+{
+    const auto now = std::chrono::steady_clock::now( );
+    const size_t pending_count = get_pending_task_count( );
+
+    uint64_t executed_count{ 0U };
+    for( const auto& thread : m_threads )
+    {
+        executed_count += thread->get_executed_count( );
+    }
+
+    if( ( pending_count == 0U ) || ( executed_count != m_last_executed_count ) )
+    {
+        m_last_executed_count = executed_count;
+        m_last_progress_time = now;
+    }
+
+    if( ( pending_count == 0U ) || ( get_thread_count( ) >= m_threads.size( ) ) )
+    {
+        return;
+    }
+
+    const bool is_deep = ( pending_count >= m_settings.elastic.grow_queue_depth ) && ( m_parked_count.load( std::memory_order_relaxed ) == 0U );
+    const bool is_stuck = ( now - m_last_progress_time ) >= std::chrono::milliseconds( m_settings.elastic.grow_wait_ms );
+    if( is_deep || is_stuck )
+    {
+        LOG_DEBUG_MSG( "Grow the pool, pending tasks: ", pending_count, ", workers: ", get_thread_count( ) );
+        start_worker( );
+        m_last_progress_time = now;
+    }
+}
+
+bool
+ThreadPool::start_worker( )
+{
+    std::lock_guard< std::mutex > lock( m_resize_mutex );
+
+    for( auto& thread : m_threads )
+    {
+        if( thread->is_active( ) )
+        {
+            continue;
+        }
+
+        // Join the retired thread, Thread could be restarted only after stop( )
+        if( thread->is_running( ) )
+        {
+            thread->stop( );
+        }
+
+        thread->set_active( true );
+        m_active_count.fetch_add( 1U, std::memory_order_relaxed );
+        if( ErrorCode::NONE != thread->start( ) )
+        {
+            LOG_ERROR_MSG( "Worker was not started: ", thread->get_name( ) );
+            thread->set_active( false );
+            m_active_count.fetch_sub( 1U, std::memory_order_relaxed );
+            return false;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+bool
+ThreadPool::try_retire( )
+{
+    uint32_t count = m_active_count.load( std::memory_order_relaxed );
+    while( count > m_min_thread_count )
+    {
+        if( m_active_count.compare_exchange_weak( count, count - 1U, std::memory_order_relaxed ) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+ThreadPool::steal_task( TaskRunner& thief, LaneTask*& task )
+{
+    const auto count = static_cast< uint32_t >( m_threads.size( ) );
+    if( count < 2U )
+    {
+        return false;
+    }
+
+    // Random start, then sweep over all the other workers once
+    const uint32_t first = thief.random_victim( count );
+    for( uint32_t i = 0U; i < count; ++i )
+    {
+        const uint32_t victim = ( first + i ) % count;
+        if( ( victim != thief.get_index( ) ) && m_threads[ victim ]->local_queue( ).steal( task ) )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 }  // namespace common
 }  // namespace uni
@@ -0,0 +1,310 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file uni/common/TimerWheel.cpp
+/// @brief Implementation hierarchical timer wheel.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "uni/common/TimerWheel.hpp"
+
+#include <algorithm>
+
+namespace uni
+{
+namespace common
+{
+namespace
+{
+constexpr uint64_t MAX_DELTA_TICKS{ ( uint64_t{ 1U } << ( TimerWheel::SLOT_BITS * TimerWheel::LEVEL_COUNT ) ) - 1U };
+}  // namespace
+
+TimerWheel::TimerWheel( Clock::duration resolution, Clock::time_point start )
+    : m_resolution{ std::max( resolution, Clock::duration{ 1 } ) }
+    , m_start{ start }
+{
+    m_slots.fill( INVALID_INDEX );
+}
+
+TimerWheel::Handle
+TimerWheel::add( Clock::time_point due, Clock::duration period, Task&& task )
+{
+    // Nothing to process in between, skip the ticks the owner slept through
+    if( 0U == m_size )
+    {
+        m_current_tick = std::max( m_current_tick, to_tick_floor( Clock::now( ) ) );
+    }
+
+    const uint32_t index = allocate( );
+    Entry& entry = m_entries[ index ];
+    entry.due_tick = std::max( to_tick_ceil( due ), m_current_tick + 1U );
+
+    if( period > Clock::duration::zero( ) )
+    {
+        entry.period_ticks = std::max< uint64_t >( 1U, ( period.count( ) + m_resolution.count( ) - 1 ) / m_resolution.count( ) );
+        entry.periodic_task = std::make_shared< Task >( std::move( task ) );
+    }
+    else
+    {
+        entry.task = std::move( task );
+    }
+
+    link( index );
+    ++m_size;
+
+    return Handle{ index, entry.generation };
+}
+
+bool
+TimerWheel::cancel( const Handle& handle )
+{
+    if( ( handle.index >= m_entries.size( ) ) || ( m_entries[ handle.index ].generation != handle.generation )
+        || ( INVALID_INDEX == m_entries[ handle.index ].slot ) )
+    {
+        return false;
+    }
+
+    unlink( handle.index );
+    release( handle.index );
+    --m_size;
+    return true;
+}
+
+size_t
+TimerWheel::size( ) const noexcept
+{
+    return m_size;
+}
+
+bool
+TimerWheel::empty( ) const noexcept
+{
+    return 0U == m_size;
+}
+
+void
+TimerWheel::advance( Clock::time_point now, const DueCallback& on_due )
+{
+    const uint64_t target_tick = to_tick_floor( now );
+    while( m_current_tick < target_tick )
+    {
+        if( 0U == m_size )
+        {
+            m_current_tick = target_tick;
+            break;
+        }
+
+        ++m_current_tick;
+
+        // Wrap of the finer wheel brings the next slot of the coarser one down, finest first
+        for( uint32_t level = 1U; level < LEVEL_COUNT; ++level )
+        {
+            const uint32_t shift = SLOT_BITS * level;
+            if( 0U != ( m_current_tick & ( ( uint64_t{ 1U } << shift ) - 1U ) ) )
+            {
+                break;
+            }
+            cascade_slot( level * SLOT_COUNT + static_cast< uint32_t >( ( m_current_tick >> shift ) & SLOT_MASK ) );
+        }
+
+        fire_slot( static_cast< uint32_t >( m_current_tick & SLOT_MASK ), target_tick, on_due );
+    }
+}
+
+void
+TimerWheel::clear( const DueCallback& on_drop )
+{
+    for( uint32_t index = 0U; index < m_entries.size( ); ++index )
+    {
+        Entry& entry = m_entries[ index ];
+        if( INVALID_INDEX == entry.slot )
+        {
+            continue;
+        }
+
+        Task task = std::move( entry.task );
+        unlink( index );
+        release( index );
+        --m_size;
+
+        if( task )
+        {
+            on_drop( std::move( task ) );
+        }
+    }
+}
+
+TimerWheel::Clock::time_point
+TimerWheel::get_next_expiry( ) const
+{
+    if( 0U == m_size )
+    {
+        return Clock::time_point::max( );
+    }
+
+    // Either a due slot of the finest wheel or its wrap, when coarser timers are cascaded
+    uint64_t tick = m_current_tick + 1U;
+    while( ( INVALID_INDEX == m_slots[ tick & SLOT_MASK ] ) && ( 0U != ( tick & SLOT_MASK ) ) )
+    {
+        ++tick;
+    }
+    return m_start + m_resolution * static_cast< Clock::rep >( tick );
+}
+
+uint64_t
+TimerWheel::to_tick_floor( Clock::time_point time ) const
+{
+    return ( time <= m_start ) ? 0U : static_cast< uint64_t >( ( time - m_start ) / m_resolution );
+}
+
+uint64_t
+TimerWheel::to_tick_ceil( Clock::time_point time ) const
+{
+    if( time <= m_start )
+    {
+        return 0U;
+    }
+
+    const auto elapsed = ( time - m_start ).count( );
+    return static_cast< uint64_t >( ( elapsed + m_resolution.count( ) - 1 ) / m_resolution.count( ) );
+}
+
+uint32_t
+TimerWheel::allocate( )
+{
+    if( INVALID_INDEX != m_free_head )
+    {
+        const uint32_t index = m_free_head;
+        m_free_head = m_entries[ index ].next;
+        m_entries[ index ].next = INVALID_INDEX;
+        return index;
+    }
+
+    m_entries.emplace_back( );
+    return static_cast< uint32_t >( m_entries.size( ) - 1U );
+}
+
+void
+TimerWheel::release( uint32_t index )
+{
+    Entry& entry = m_entries[ index ];
+    entry.task.reset( );
+    entry.periodic_task.reset( );
+    entry.period_ticks = 0U;
+    entry.prev = INVALID_INDEX;
+    entry.slot = INVALID_INDEX;
+    ++entry.generation;  // Invalidates the handles
+
+    entry.next = m_free_head;
+    m_free_head = index;
+}
+
+void
+TimerWheel::link( uint32_t index )
+{
+    Entry& entry = m_entries[ index ];
+
+    // Timers beyond the range wait at the top level and are re-linked on every its turn
+    const uint64_t delta = std::min( entry.due_tick - std::min( entry.due_tick, m_current_tick ), MAX_DELTA_TICKS );
+    const uint64_t placed_tick = m_current_tick + delta;
+
+    uint32_t level = 0U;
+    while( ( level + 1U < LEVEL_COUNT ) && ( delta >= ( uint64_t{ 1U } << ( SLOT_BITS * ( level + 1U ) ) ) ) )
+    {
+        ++level;
+    }
+
+    const uint32_t slot = level * SLOT_COUNT + static_cast< uint32_t >( ( placed_tick >> ( SLOT_BITS * level ) ) & SLOT_MASK );
+    entry.slot = slot;
+    entry.prev = INVALID_INDEX;
+    entry.next = m_slots[ slot ];
+    if( INVALID_INDEX != entry.next )
+    {
+        m_entries[ entry.next ].prev = index;
+    }
+    m_slots[ slot ] = index;
+}
+
+void
+TimerWheel::unlink( uint32_t index )
+{
+    Entry& entry = m_entries[ index ];
+    if( INVALID_INDEX != entry.prev )
+    {
+        m_entries[ entry.prev ].next = entry.next;
+    }
+    else
+    {
+        m_slots[ entry.slot ] = entry.next;
+    }
+
+    if( INVALID_INDEX != entry.next )
+    {
+        m_entries[ entry.next ].prev = entry.prev;
+    }
+
+    entry.prev = INVALID_INDEX;
+    entry.next = INVALID_INDEX;
+    entry.slot = INVALID_INDEX;
+}
+
+uint32_t
+TimerWheel::detach_slot( uint32_t slot )
+{
+    const uint32_t head = m_slots[ slot ];
+    m_slots[ slot ] = INVALID_INDEX;
+    return head;
+}
+
+void
+TimerWheel::fire_slot( uint32_t slot, uint64_t target_tick, const DueCallback& on_due )
+{
+    uint32_t index = detach_slot( slot );
+    while( INVALID_INDEX != index )
+    {
+        Entry& entry = m_entries[ index ];
+        const uint32_t next = entry.next;
+        entry.slot = INVALID_INDEX;
+
+        if( entry.due_tick > m_current_tick )
+        {
+            // Clamped timer of the top level, not due yet
+            link( index );
+        }
+        else if( 0U != entry.period_ticks )
+        {
+            on_due( Task{ [ task = entry.periodic_task ]( ) { ( *task )( ); } } );
+
+            // The periods missed by the late advance( ) are skipped, the phase is kept
+            entry.due_tick += entry.period_ticks;
+            if( entry.due_tick <= target_tick )
+            {
+                entry.due_tick += ( ( target_tick - entry.due_tick ) / entry.period_ticks + 1U ) * entry.period_ticks;
+            }
+            link( index );
+        }
+        else
+        {
+            Task task{ std::move( entry.task ) };
+            release( index );
+            --m_size;
+            on_due( std::move( task ) );
+        }
+
+        index = next;
+    }
+}
+
+void
+TimerWheel::cascade_slot( uint32_t slot )
+{
+    uint32_t index = detach_slot( slot );
+    while( INVALID_INDEX != index )
+    {
+        const uint32_t next = m_entries[ index ].next;
+        link( index );
+        index = next;
+    }
+}
+
+}  // namespace common
+}  // namespace uni
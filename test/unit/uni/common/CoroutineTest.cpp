@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file test/uni/common/CoroutineTest.cpp
+/// @brief Implementation coroutine test class.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "CoroutineTest.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+const std::string NAME_TEST_POOL{ "TEST_CoroPool" };
+constexpr uint32_t TEST_THREAD_COUNT{ 4U };
+}  // namespace
+
+namespace test
+{
+namespace uni
+{
+namespace common
+{
+void
+CoroutineTest::SetUp( )
+{
+    ASSERT_NO_FATAL_FAILURE( Base::SetUp( ) );
+}
+
+void
+CoroutineTest::TearDown( )
+{
+    ASSERT_NO_FATAL_FAILURE( Base::TearDown( ) );
+}
+
+::uni::common::ThreadPool&
+CoroutineTest::get_pool( )
+{
+    static ::uni::common::ThreadPool pool{ [] {
+        ::uni::common::ThreadPool::Settings settings{};
+        settings.thread_settings.name = NAME_TEST_POOL;
+        settings.thread_count = TEST_THREAD_COUNT;
+        return settings;
+    }( ) };
+    return pool;
+}
+
+#if defined( __cpp_impl_coroutine )
+
+namespace
+{
+using ::uni::common::ThreadPool;
+namespace coro = ::uni::common::coro;
+
+coro::Task< std::thread::id >
+get_worker_id( ThreadPool& pool )
+{
+    co_await pool.schedule( );
+    co_return std::this_thread::get_id( );
+}
+
+coro::Task< uint32_t >
+square( ThreadPool& pool, uint32_t value )
+{
+    co_await pool.schedule( );
+    co_return value * value;
+}
+
+coro::Task< uint32_t >
+sum_of_squares( ThreadPool& pool, uint32_t count )
+{
+    uint32_t sum{ 0U };
+    for( uint32_t i = 1U; i <= count; ++i )
+    {
+        sum += co_await square( pool, i );
+    }
+    co_return sum;
+}
+
+coro::Task< uint32_t >
+fail( ThreadPool& pool )
+{
+    co_await pool.schedule( );
+    throw std::runtime_error( "failed" );
+}
+
+coro::Task< uint32_t >
+delayed( ThreadPool& pool, uint32_t value, std::chrono::milliseconds delay )
+{
+    co_await coro::sleep_for( pool, delay );
+    co_return value;
+}
+
+coro::Task< void >
+notify( std::promise< void >& promise )
+{
+    promise.set_value( );
+    co_return;
+}
+}  // namespace
+
+TEST_F( CoroutineTest, ScheduleResumesOnWorker )
+{
+    ASSERT_NE( std::this_thread::get_id( ), coro::sync_wait( get_worker_id( get_pool( ) ) ) );
+}
+
+TEST_F( CoroutineTest, TaskChaining )
+{
+    ASSERT_EQ( 385U, coro::sync_wait( sum_of_squares( get_pool( ), 10U ) ) );
+}
+
+TEST_F( CoroutineTest, ExceptionPropagates )
+{
+    ASSERT_THROW( coro::sync_wait( fail( get_pool( ) ) ), std::runtime_error );
+}
+
+TEST_F( CoroutineTest, WhenAll )
+{
+    const auto [ first, second ] = coro::sync_wait( coro::when_all( square( get_pool( ), 3U ), square( get_pool( ), 4U ) ) );
+    ASSERT_EQ( 9U, first );
+    ASSERT_EQ( 16U, second );
+
+    std::vector< coro::Task< uint32_t > > tasks;
+    for( uint32_t i = 0U; i < 100U; ++i )
+    {
+        tasks.push_back( square( get_pool( ), i ) );
+    }
+    const auto results = coro::sync_wait( coro::when_all( std::move( tasks ) ) );
+    ASSERT_EQ( 100U, results.size( ) );
+    ASSERT_EQ( 99U * 99U, results.back( ) );
+}
+
+TEST_F( CoroutineTest, WhenAny )
+{
+    std::vector< coro::Task< uint32_t > > tasks;
+    tasks.push_back( delayed( get_pool( ), 1U, std::chrono::milliseconds( 500 ) ) );
+    tasks.push_back( delayed( get_pool( ), 2U, std::chrono::milliseconds( 1 ) ) );
+
+    const auto [ index, value ] = coro::sync_wait( coro::when_any( std::move( tasks ) ) );
+    ASSERT_EQ( 1U, index );
+    ASSERT_EQ( 2U, value );
+}
+
+TEST_F( CoroutineTest, SleepFor )
+{
+    const auto start = std::chrono::steady_clock::now( );
+    ASSERT_EQ( 7U, coro::sync_wait( delayed( get_pool( ), 7U, std::chrono::milliseconds( 20 ) ) ) );
+    ASSERT_GE( std::chrono::steady_clock::now( ) - start, std::chrono::milliseconds( 20 ) );
+}
+
+TEST_F( CoroutineTest, SyncWaitAcrossShutdown )
+{
+    ThreadPool pool{ [] {
+        ThreadPool::Settings settings{};
+        settings.thread_settings.name = NAME_TEST_POOL;
+        settings.thread_count = 1U;
+        return settings;
+    }( ) };
+
+    // The only worker is busy, so the resume of the scheduled coroutine stays queued
+    std::atomic< bool > is_released{ false };
+    ASSERT_TRUE( pool.submit( [ &is_released ] {
+        while( !is_released )
+        {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+        }
+    } ).valid( ) );
+
+    // when_all( ) runs the children up to their first suspension in order, notify( ) runs after both are queued
+    std::promise< void > suspended;
+    auto is_suspended = suspended.get_future( );
+    bool is_cancelled{ false };
+    std::thread waiter( [ & ] {
+        try
+        {
+            coro::sync_wait( coro::when_all( square( pool, 2U ), delayed( pool, 1U, std::chrono::hours( 1 ) ), notify( suspended ) ) );
+        }
+        catch( const std::future_error& error )
+        {
+            is_cancelled = ( std::future_errc::broken_promise == error.code( ) );
+        }
+    } );
+    is_suspended.wait( );
+
+    std::thread releaser( [ &is_released ] {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+        is_released = true;
+    } );
+    const auto stats = pool.shutdown( ThreadPool::ShutdownMode::CANCEL );
+    releaser.join( );
+    waiter.join( );
+
+    ASSERT_TRUE( is_cancelled );
+    ASSERT_EQ( 1U, stats.dropped_count );
+}
+
+#endif
+
+}  // namespace common
+}  // namespace uni
+}  // namespace test
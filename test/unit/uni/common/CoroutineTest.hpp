@@ -0,0 +1,43 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file test/uni/common/CoroutineTest.hpp
+/// @brief Declaration coroutine test class.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <uni/common/Coroutine.hpp>
+#include <uni/common/ThreadPool.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+
+namespace test
+{
+namespace uni
+{
+namespace common
+{
+class CoroutineTest : public testing::Test
+{
+    using Base = testing::Test;
+
+public:
+    CoroutineTest( ) = default;
+    ~CoroutineTest( ) override = default;
+
+    // Test
+private:
+    void SetUp( ) override;
+    void TearDown( ) override;
+
+protected:
+    /// Shared by the tests, so the slow coroutines left by WhenAny do not keep a per-test pool alive
+    static ::uni::common::ThreadPool& get_pool( );
+};
+
+}  // namespace common
+}  // namespace uni
+}  // namespace test
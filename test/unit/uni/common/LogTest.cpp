@@ -0,0 +1,521 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file test/uni/common/LogTest.cpp
+/// @brief Implementation logger test class.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "LogTest.hpp"
+
+#include <uni/common/Queue.hpp>
+#include <uni/common/Thread.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace test
+{
+namespace uni
+{
+namespace common
+{
+using ::uni::common::ErrorCode;
+using ::uni::common::Log;
+using ::uni::common::LogLevel;
+using ::uni::common::QueueMetrics;
+using ::uni::common::logger;
+
+namespace
+{
+struct Named
+{
+    std::string name{};
+
+    LOG_CLASS( Named, LOG_IT( name ) );
+};
+
+/// Has only operator<<, its text goes to JSON as a string
+struct Streamed
+{
+};
+
+std::ostream&
+operator<<( std::ostream& out, const Streamed& )
+{
+    return out << "say \"hi\"";
+}
+
+/// Owns its whole value, stored as raw bytes by the binary records
+struct Point
+{
+    int x{ 0 };
+    int y{ 0 };
+
+    friend std::ostream&
+    operator<<( std::ostream& out, const Point& point )
+    {
+        return out << "(" << point.x << "," << point.y << ")";
+    }
+};
+
+/// Logs while its own record is being formatted
+struct Nested
+{
+    friend std::ostream&
+    operator<<( std::ostream& out, const Nested& )
+    {
+        LOG_INFO_MSG( "inner" );
+        return out << "outer";
+    }
+};
+}  // namespace
+}  // namespace common
+}  // namespace uni
+}  // namespace test
+
+template <>
+constexpr bool ::uni::common::binary_log::ALLOW_RAW< test::uni::common::Point > = true;
+
+namespace test
+{
+namespace uni
+{
+namespace common
+{
+void
+LogTest::SetUp( )
+{
+    ASSERT_NO_FATAL_FAILURE( Base::SetUp( ) );
+    m_cout_buffer = std::cout.rdbuf( m_output.rdbuf( ) );
+}
+
+void
+LogTest::TearDown( )
+{
+    logger( ).stop_async( );
+    std::cout.rdbuf( m_cout_buffer );
+    ASSERT_NO_FATAL_FAILURE( Base::TearDown( ) );
+}
+
+TEST_F( LogTest, AsyncKeepsEveryRecordInOrder )
+{
+    constexpr uint32_t THREAD_COUNT{ 4U };
+    constexpr uint32_t RECORD_COUNT{ 2000U };
+
+    Log::AsyncSettings settings;
+    settings.capacity = 64U;
+    ASSERT_EQ( ErrorCode::NONE, logger( ).start_async( settings ) );
+    ASSERT_EQ( ErrorCode::INTERNAL, logger( ).start_async( settings ) );
+    ASSERT_TRUE( logger( ).is_async( ) );
+
+    std::vector< std::thread > threads;
+    for( uint32_t thread = 0U; thread < THREAD_COUNT; ++thread )
+    {
+        threads.emplace_back( [ thread ] {
+            for( uint32_t i = 0U; i < RECORD_COUNT; ++i )
+            {
+                LOG_INFO_MSG( "async ", thread, ":", i, ";" );
+            }
+        } );
+    }
+    for( auto& thread : threads )
+    {
+        thread.join( );
+    }
+
+    ASSERT_EQ( ErrorCode::NONE, logger( ).stop_async( ) );
+    ASSERT_FALSE( logger( ).is_async( ) );
+    LOG_INFO_MSG( "sync after stop" );
+
+    // Every record of the thread is there and in the order of the calls
+    const std::string output = m_output.str( );
+    for( uint32_t thread = 0U; thread < THREAD_COUNT; ++thread )
+    {
+        size_t position{ 0U };
+        for( uint32_t i = 0U; i < RECORD_COUNT; ++i )
+        {
+            position = output.find( "async " + std::to_string( thread ) + ":" + std::to_string( i ) + ";", position );
+            ASSERT_NE( std::string::npos, position );
+        }
+    }
+    ASSERT_NE( std::string::npos, output.find( "sync after stop" ) );
+    ASSERT_EQ( 0U, logger( ).get_dropped_count( ) );
+}
+
+TEST_F( LogTest, AsyncRestartWhileLogging )
+{
+    constexpr uint32_t THREAD_COUNT{ 4U };
+    constexpr uint32_t RESTART_COUNT{ 50U };
+
+    std::atomic< bool > is_done{ false };
+    std::vector< std::thread > threads;
+    for( uint32_t thread = 0U; thread < THREAD_COUNT; ++thread )
+    {
+        threads.emplace_back( [ &is_done ] {
+            while( !is_done )
+            {
+                LOG_INFO_MSG( "restart" );
+            }
+        } );
+    }
+
+    // The callers that loaded the stopped writer are still inside it when the next one starts
+    Log::AsyncSettings settings;
+    settings.capacity = 16U;
+    for( uint32_t i = 0U; i < RESTART_COUNT; ++i )
+    {
+        settings.is_binary = ( 0U != ( i % 2U ) );
+        ASSERT_EQ( ErrorCode::NONE, logger( ).start_async( settings ) );
+        std::this_thread::sleep_for( std::chrono::microseconds( 200 ) );
+        ASSERT_EQ( ErrorCode::NONE, logger( ).stop_async( ) );
+    }
+
+    is_done = true;
+    for( auto& thread : threads )
+    {
+        thread.join( );
+    }
+    ASSERT_NE( std::string::npos, m_output.str( ).find( "restart" ) );
+}
+
+TEST_F( LogTest, StopAsyncKeepsConcurrentRecords )
+{
+    constexpr uint32_t THREAD_COUNT{ 4U };
+    constexpr uint32_t RECORD_COUNT{ 2000U };
+
+    for( const bool is_binary : { false, true } )
+    {
+        m_output.str( std::string( ) );
+        Log::AsyncSettings settings;
+        settings.capacity = 64U;
+        settings.is_binary = is_binary;
+        ASSERT_EQ( ErrorCode::NONE, logger( ).start_async( settings ) );
+
+        // Every call that returned before or during stop_async( ) is written: by the writer or synchronously
+        std::atomic< uint32_t > started{ 0U };
+        std::vector< std::thread > threads;
+        for( uint32_t thread = 0U; thread < THREAD_COUNT; ++thread )
+        {
+            threads.emplace_back( [ thread, &started ] {
+                ++started;
+                for( uint32_t i = 0U; i < RECORD_COUNT; ++i )
+                {
+                    LOG_INFO_MSG( "stop ", thread, ":", i, ";" );
+                }
+            } );
+        }
+        while( started < THREAD_COUNT )
+        {
+            std::this_thread::yield( );
+        }
+        ASSERT_EQ( ErrorCode::NONE, logger( ).stop_async( ) );
+        for( auto& thread : threads )
+        {
+            thread.join( );
+        }
+
+        // Collected in one pass: a search of the whole output per record is quadratic
+        const std::string output = m_output.str( );
+        std::unordered_set< std::string > records;
+        for( size_t begin = output.find( "stop " ); std::string::npos != begin; begin = output.find( "stop ", begin + 1U ) )
+        {
+            records.insert( output.substr( begin, output.find( ';', begin ) - begin ) );
+        }
+        for( uint32_t thread = 0U; thread < THREAD_COUNT; ++thread )
+        {
+            for( uint32_t i = 0U; i < RECORD_COUNT; ++i )
+            {
+                ASSERT_EQ( 1U, records.count( "stop " + std::to_string( thread ) + ":" + std::to_string( i ) ) ) << is_binary;
+            }
+        }
+    }
+}
+
+TEST_F( LogTest, BinaryMatchesText )
+{
+    const std::string name{ "name" };
+    const QueueMetrics metrics{ 1U, 2U, 3U, 4U };
+    const Named named{ "named" };  // Not trivially copyable, formatted by the caller
+    const auto log_all = [ & ] {
+        LOG_INFO_MSG( "binary ", name, " ", 42, " ", 1.5, " ", LogLevel::ERROR, " ", metrics, " ", named );
+        LOG_INFO_MSG( "too long for the record ", std::string( 300U, 'x' ) );
+        LOG_INFO_MSG( "last" );
+    };
+
+    log_all( );
+    const std::string text = m_output.str( );
+    m_output.str( std::string( ) );
+
+    Log::AsyncSettings settings;
+    settings.is_binary = true;
+    ASSERT_EQ( ErrorCode::NONE, logger( ).start_async( settings ) );
+    log_all( );
+    ASSERT_EQ( ErrorCode::NONE, logger( ).stop_async( ) );
+
+    // The previous writer might report its destruction, only the records of the test are compared
+    std::istringstream lines{ m_output.str( ) };
+    std::string binary;
+    for( std::string line; std::getline( lines, line ); )
+    {
+        if( std::string::npos != line.find( "LogTest" ) )
+        {
+            binary += line + "\n";
+        }
+    }
+    ASSERT_EQ( text, binary );
+}
+
+TEST_F( LogTest, BinaryCopiesViewedText )
+{
+    static_assert( ::uni::common::binary_log::IS_RAW< Point > );
+    static_assert( !::uni::common::binary_log::IS_RAW< const int* > );
+
+    Log::AsyncSettings settings;
+    settings.is_binary = true;
+    ASSERT_EQ( ErrorCode::NONE, logger( ).start_async( settings ) );
+    {
+        // The caller reuses the buffer before the writer formats the record
+        char buffer[ 16 ];
+        std::snprintf( buffer, sizeof( buffer ), "%s", "original" );
+        LOG_INFO_MSG( "view ", std::string_view{ buffer }, " ", Point{ 1, 2 } );
+        std::snprintf( buffer, sizeof( buffer ), "%s", "overwritten" );
+    }
+    ASSERT_EQ( ErrorCode::NONE, logger( ).stop_async( ) );
+
+    const std::string output = m_output.str( );
+    ASSERT_NE( std::string::npos, output.find( "view original (1,2)" ) );
+    ASSERT_EQ( std::string::npos, output.find( "overwritten" ) );
+}
+
+TEST_F( LogTest, ComponentLevels )
+{
+    using ::uni::common::LogComponent;
+    using ::uni::common::LogLevel;
+
+    uint32_t evaluated_count{ 0U };
+    auto count = [ &evaluated_count ] { return ++evaluated_count; };
+
+    logger( ).set_log_level( LogComponent::THREAD, LogLevel::ERROR );
+    LOG_COMPONENT_MSG( LogComponent::THREAD, LogLevel::INFO, "func", "filtered ", count( ) );
+    LOG_COMPONENT_MSG( LogComponent::THREAD, LogLevel::ERROR, "func", "thread error ", count( ) );
+    LOG_INFO_MSG( "general info ", count( ) );
+    logger( ).set_log_level( LogComponent::THREAD, LogLevel::DEBUG );
+
+    // The arguments of the filtered call are not evaluated
+    EXPECT_EQ( 2U, evaluated_count );
+    EXPECT_EQ( LogLevel::DEBUG, logger( ).get_log_level( LogComponent::THREAD ) );
+    const std::string output = m_output.str( );
+    EXPECT_EQ( std::string::npos, output.find( "filtered" ) );
+    EXPECT_NE( std::string::npos, output.find( "thread error 1" ) );
+    EXPECT_NE( std::string::npos, output.find( "general info 2" ) );
+}
+
+TEST_F( LogTest, ThreadNameAndNestedRecord )
+{
+    auto log_named = [] {
+        std::thread thread{ [] {
+            ::uni::common::set_current_thread_name( "log_named" );
+            LOG_INFO_MSG( "named ", std::hex, 255 );
+            LOG_INFO_MSG( "decimal ", 255 );
+        } };
+        thread.join( );
+    };
+
+    log_named( );
+    LOG_INFO_MSG( Nested{ } );
+    const std::string text = m_output.str( );
+    EXPECT_NE( std::string::npos, text.find( ":log_named\" \"LogLevel::INFO\"" ) );
+    EXPECT_NE( std::string::npos, text.find( "named ff\n" ) );
+    EXPECT_NE( std::string::npos, text.find( "decimal 255\n" ) );
+    EXPECT_NE( std::string::npos, text.find( "inner\n" ) );
+    EXPECT_NE( std::string::npos, text.find( "outer\n" ) );
+
+    m_output.str( std::string( ) );
+    Log::AsyncSettings settings;
+    settings.is_binary = true;
+    ASSERT_EQ( ErrorCode::NONE, logger( ).start_async( settings ) );
+    log_named( );
+    ASSERT_EQ( ErrorCode::NONE, logger( ).stop_async( ) );
+    EXPECT_NE( std::string::npos, m_output.str( ).find( ":log_named\" \"LogLevel::INFO\"" ) );
+}
+
+TEST_F( LogTest, LimitedMacros )
+{
+    auto count = [ this ]( const std::string& text ) {
+        size_t result{ 0U };
+        const std::string output = m_output.str( );
+        for( size_t position = output.find( text ); std::string::npos != position; position = output.find( text, position + 1U ) )
+        {
+            ++result;
+        }
+        return result;
+    };
+
+    auto every_ms = [] { LOG_EVERY_MS( INFO, 50U, "every ms" ); };
+
+    auto required = []( bool condition ) {
+        REQUIRED_LIMITED( condition, "required failed", false );
+        return true;
+    };
+
+    for( uint32_t i = 0U; i < 10U; ++i )
+    {
+        LOG_EVERY_N( INFO, 3U, "every n ", i );
+        LOG_FIRST_N( INFO, 2U, "first n ", i );
+        LOG_RATE_LIMITED( INFO, 1U, 3U, "rate limited ", i );
+        every_ms( );
+        EXPECT_FALSE( required( false ) );
+    }
+    EXPECT_EQ( 4U, count( "every n " ) );
+    EXPECT_EQ( 1U, count( "every n 9" ) );
+    EXPECT_EQ( 2U, count( "first n " ) );
+    EXPECT_EQ( 3U, count( "rate limited " ) );
+    EXPECT_EQ( 1U, count( "every ms" ) );
+    EXPECT_EQ( 1U, count( "required failed" ) );
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( 60 ) );
+    every_ms( );
+    EXPECT_EQ( 2U, count( "every ms" ) );
+    EXPECT_EQ( 1U, count( "every ms (suppressed: 9)" ) );
+}
+
+TEST_F( LogTest, MappedFileSinkRotates )
+{
+    using ::uni::common::MappedFileLogSink;
+
+    auto read_file = []( const std::string& path ) {
+        std::ifstream file{ path };
+        std::ostringstream content;
+        content << file.rdbuf( );
+        return content.str( );
+    };
+
+    MappedFileLogSink::Settings sink_settings;
+    sink_settings.path = testing::TempDir( ) + "uni_log_sink_test.log";
+    sink_settings.file_size = 4096U;
+    sink_settings.max_file_count = 3U;
+    auto sink = std::make_shared< MappedFileLogSink >( sink_settings );
+    ASSERT_EQ( ErrorCode::NONE, sink->open( ) );
+    ASSERT_EQ( ErrorCode::NONE, logger( ).set_sink( sink ) );
+
+    for( uint32_t i = 0U; i < 200U; ++i )
+    {
+        LOG_INFO_MSG( "mapped ", i, " ", std::string( 64U, 'x' ) );
+    }
+
+    ASSERT_EQ( ErrorCode::NONE, logger( ).set_sink( std::make_shared< ::uni::common::NullLogSink >( ) ) );
+    EXPECT_EQ( 1, sink.use_count( ) );  // Released by the swap, not kept until flush( )
+    LOG_INFO_MSG( "null sink" );
+    ASSERT_EQ( ErrorCode::NONE, logger( ).set_sink( std::make_shared< ::uni::common::OstreamLogSink >( std::cout ) ) );
+    logger( ).flush( );
+    sink.reset( );
+
+    // The last records are in the current file, every file holds only complete lines
+    const std::string current = read_file( sink_settings.path );
+    const std::string previous = read_file( sink_settings.path + ".1" );
+    EXPECT_NE( std::string::npos, current.find( "mapped 199 " ) );
+    EXPECT_LE( current.size( ), sink_settings.file_size );
+    EXPECT_EQ( '\n', current.back( ) );
+    EXPECT_EQ( '\n', previous.back( ) );
+    EXPECT_FALSE( read_file( sink_settings.path + ".2" ).empty( ) );
+    EXPECT_TRUE( read_file( sink_settings.path + ".3" ).empty( ) );
+    EXPECT_EQ( std::string::npos, m_output.str( ).find( "null sink" ) );
+
+    for( const char* suffix : { "", ".1", ".2" } )
+    {
+        std::remove( ( sink_settings.path + suffix ).c_str( ) );
+    }
+}
+
+TEST_F( LogTest, MappedFileSinkRetriesFailedRotation )
+{
+    using ::uni::common::MappedFileLogSink;
+
+    const std::string directory = testing::TempDir( ) + "uni_log_sink_retry";
+    std::filesystem::create_directory( directory );
+
+    MappedFileLogSink::Settings sink_settings;
+    sink_settings.path = directory + "/retry.log";
+    sink_settings.file_size = 64U;
+    sink_settings.max_file_count = 2U;
+    sink_settings.retry_interval_ms = 500U;
+    {
+        MappedFileLogSink sink{ sink_settings };
+        ASSERT_EQ( ErrorCode::NONE, sink.open( ) );
+
+        const std::string first{ "first\n" };
+        const std::string long_line( 60U, 'x' );
+        const std::string second{ "second\n" };
+        sink.write( first.data( ), first.size( ) );
+
+        // The next file can not be created, the line is dropped
+        std::filesystem::remove_all( directory );
+        sink.write( long_line.data( ), long_line.size( ) );
+        ASSERT_EQ( long_line.size( ), sink.get_dropped_size( ) );
+
+        // Not retried on every write, but not dropped forever: the write after the retry interval opens the file again
+        std::filesystem::create_directory( directory );
+        sink.write( first.data( ), first.size( ) );
+        ASSERT_EQ( long_line.size( ) + first.size( ), sink.get_dropped_size( ) );
+        std::this_thread::sleep_for( std::chrono::milliseconds( sink_settings.retry_interval_ms ) );
+        sink.write( second.data( ), second.size( ) );
+        ASSERT_EQ( long_line.size( ) + first.size( ), sink.get_dropped_size( ) );
+    }
+
+    std::ifstream file{ sink_settings.path };
+    std::ostringstream content;
+    content << file.rdbuf( );
+    EXPECT_EQ( "second\n", content.str( ) );
+
+    std::filesystem::remove_all( directory );
+}
+
+TEST_F( LogTest, JsonWriter )
+{
+    using ::uni::common::JsonWriter;
+
+    ::uni::common::Thread::Settings settings;
+    settings.name = "quote\" slash\\ line\n";
+    settings.repeat_type = ::uni::common::Thread::Repeat::LOOP;
+    settings.timeout_ms = 250U;
+    settings.cpu_affinity = { 3U, 1U };
+    const std::string expected{
+        R"({"name":"quote\" slash\\ line\n","repeat_type":"Thread::Repeat::LOOP","timeout_ms":250,"cpu_affinity":[1,3]})" };
+
+    char buffer[ 256 ];
+    JsonWriter writer{ buffer, sizeof( buffer ) };
+    settings.serialize_json( writer );
+    ASSERT_FALSE( writer.is_overflow( ) );
+    EXPECT_EQ( expected, std::string( buffer, writer.size( ) ) );
+
+    // The small buffer is not overrun and tells the size needed
+    JsonWriter small_writer{ buffer, 16U };
+    settings.serialize_json( small_writer );
+    EXPECT_TRUE( small_writer.is_overflow( ) );
+    EXPECT_EQ( expected.size( ), small_writer.size( ) );
+
+    std::ostringstream out;
+    out << settings;
+    EXPECT_EQ( expected, out.str( ) );
+
+    JsonWriter value_writer{ buffer, sizeof( buffer ) };
+    ::uni::common::write_json( value_writer, std::vector< double >{ 0.5, -2.0 } );
+    ::uni::common::write_json( value_writer, true );
+    ::uni::common::write_json( value_writer, Named{ std::string( "\x01" ) } );
+    ::uni::common::write_json( value_writer, static_cast< const char* >( nullptr ) );
+    ::uni::common::write_json( value_writer, Streamed{ } );
+    EXPECT_EQ( R"([0.5,-2]true{"name":"\u0001"}null"say \"hi\"")", std::string( buffer, value_writer.size( ) ) );
+}
+
+}  // namespace common
+}  // namespace uni
+}  // namespace test
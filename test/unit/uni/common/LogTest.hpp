@@ -0,0 +1,44 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file test/uni/common/LogTest.hpp
+/// @brief Declaration logger test class.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <uni/common/Log.hpp>
+
+#include <sstream>
+#include <streambuf>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace test
+{
+namespace uni
+{
+namespace common
+{
+class LogTest : public testing::Test
+{
+    using Base = testing::Test;
+
+public:
+    LogTest( ) = default;
+    ~LogTest( ) override = default;
+
+    // Test
+private:
+    void SetUp( ) override;
+    void TearDown( ) override;
+
+protected:
+    std::ostringstream m_output{};  //< Replaces std::cout during the test
+    std::streambuf* m_cout_buffer{ nullptr };
+};
+
+}  // namespace common
+}  // namespace uni
+}  // namespace test
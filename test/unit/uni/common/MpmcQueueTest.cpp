@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file test/uni/common/MpmcQueueTest.cpp
+/// @brief Implementation lock-free MPMC queue test class.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "MpmcQueueTest.hpp"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace test
+{
+namespace uni
+{
+namespace common
+{
+using ::uni::common::MpmcQueue;
+using ::uni::common::OperationStatus;
+
+void
+MpmcQueueTest::SetUp( )
+{
+    ASSERT_NO_FATAL_FAILURE( Base::SetUp( ) );
+}
+
+void
+MpmcQueueTest::TearDown( )
+{
+    ASSERT_NO_FATAL_FAILURE( Base::TearDown( ) );
+}
+
+TEST_F( MpmcQueueTest, BoundedFifo )
+{
+    MpmcQueue< std::unique_ptr< int > > queue{ 3U };
+    ASSERT_EQ( 4U, queue.capacity( ) );
+
+    for( int i = 0; i < 4; ++i )
+    {
+        ASSERT_EQ( OperationStatus::SUCCESS, queue.try_push( std::make_unique< int >( i ) ) );
+    }
+
+    auto rejected = std::make_unique< int >( 4 );
+    ASSERT_EQ( OperationStatus::UNSUCCESS, queue.try_push( std::move( rejected ) ) );
+    ASSERT_NE( nullptr, rejected );
+    ASSERT_EQ( 4U, queue.size( ) );
+
+    std::unique_ptr< int > value;
+    for( int i = 0; i < 4; ++i )
+    {
+        ASSERT_EQ( OperationStatus::SUCCESS, queue.try_pop( value ) );
+        ASSERT_EQ( i, *value );
+    }
+    ASSERT_EQ( OperationStatus::UNSUCCESS, queue.try_pop( value ) );
+    ASSERT_TRUE( queue.empty( ) );
+}
+
+TEST_F( MpmcQueueTest, DestructorDestroysLeftElements )
+{
+    // Not default constructible, the destructor must not need a spare element
+    struct Element
+    {
+        explicit Element( std::shared_ptr< int > value )
+            : value{ std::move( value ) }
+        {
+        }
+
+        std::shared_ptr< int > value;
+    };
+
+    const auto tracker = std::make_shared< int >( 0 );
+    {
+        MpmcQueue< Element > queue{ 4U };
+        for( int i = 0; i < 6; ++i )
+        {
+            // Wraps around the ring: the left elements are not at the start of the buffer
+            ASSERT_EQ( OperationStatus::SUCCESS, queue.try_push( Element{ tracker } ) );
+            if( i < 3 )
+            {
+                Element popped{ nullptr };
+                ASSERT_EQ( OperationStatus::SUCCESS, queue.try_pop( popped ) );
+            }
+        }
+        ASSERT_EQ( 4, tracker.use_count( ) );
+    }
+    ASSERT_EQ( 1, tracker.use_count( ) );
+}
+
+TEST_F( MpmcQueueTest, CloseWakesConsumers )
+{
+    MpmcQueue< int > queue{ 8U };
+    queue.push( 1 );
+
+    std::atomic< uint32_t > closed_count{ 0U };
+    std::vector< std::thread > consumers;
+    int popped{ 0 };
+    for( uint32_t i = 0U; i < 2U; ++i )
+    {
+        consumers.emplace_back( [ & ] {
+            int value{ 0 };
+            while( OperationStatus::SUCCESS == queue.wait_pop( value ) )
+            {
+                popped = value;
+            }
+            ++closed_count;
+        } );
+    }
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+    queue.close( );
+    for( auto& consumer : consumers )
+    {
+        consumer.join( );
+    }
+
+    ASSERT_EQ( 1, popped );
+    ASSERT_EQ( 2U, closed_count.load( ) );
+    ASSERT_EQ( OperationStatus::CLOSED, queue.try_push( 2 ) );
+}
+
+TEST_F( MpmcQueueTest, ManyProducersManyConsumers )
+{
+    constexpr uint64_t PRODUCER_COUNT{ 4U };
+    constexpr uint64_t CONSUMER_COUNT{ 4U };
+    constexpr uint64_t ITEM_COUNT{ 20000U };
+
+    // Small capacity keeps both sides blocking on full and empty
+    MpmcQueue< uint64_t > queue{ 16U };
+    std::atomic< uint64_t > sum{ 0U };
+    std::atomic< uint64_t > count{ 0U };
+
+    std::vector< std::thread > consumers;
+    for( uint64_t i = 0U; i < CONSUMER_COUNT; ++i )
+    {
+        consumers.emplace_back( [ & ] {
+            uint64_t value{ 0U };
+            while( OperationStatus::SUCCESS == queue.wait_pop( value ) )
+            {
+                sum += value;
+                ++count;
+            }
+        } );
+    }
+
+    std::vector< std::thread > producers;
+    for( uint64_t i = 0U; i < PRODUCER_COUNT; ++i )
+    {
+        producers.emplace_back( [ & ] {
+            for( uint64_t value = 1U; value <= ITEM_COUNT; ++value )
+            {
+                queue.push( value );
+            }
+        } );
+    }
+
+    for( auto& producer : producers )
+    {
+        producer.join( );
+    }
+    queue.close( );
+    for( auto& consumer : consumers )
+    {
+        consumer.join( );
+    }
+
+    ASSERT_EQ( PRODUCER_COUNT * ITEM_COUNT, count.load( ) );
+    ASSERT_EQ( PRODUCER_COUNT * ITEM_COUNT * ( ITEM_COUNT + 1U ) / 2U, sum.load( ) );
+}
+
+}  // namespace common
+}  // namespace uni
+}  // namespace test
@@ -0,0 +1,37 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file test/uni/common/MpmcQueueTest.hpp
+/// @brief Declaration lock-free MPMC queue test class.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <uni/common/MpmcQueue.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace test
+{
+namespace uni
+{
+namespace common
+{
+class MpmcQueueTest : public testing::Test
+{
+    using Base = testing::Test;
+
+public:
+    MpmcQueueTest( ) = default;
+    ~MpmcQueueTest( ) override = default;
+
+    // Test
+private:
+    void SetUp( ) override;
+    void TearDown( ) override;
+};
+
+}  // namespace common
+}  // namespace uni
+}  // namespace test
@@ -0,0 +1,311 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file test/uni/common/QueueTest.cpp
+/// @brief Implementation thread safe queue test class.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "QueueTest.hpp"
+
+#include <uni/common/MpmcQueue.hpp>
+#include <uni/common/PriorityQueue.hpp>
+#include <uni/common/QueueSet.hpp>
+#include <uni/common/RingBuffer.hpp>
+
+#include <chrono>
+#include <iterator>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace test
+{
+namespace uni
+{
+namespace common
+{
+using ::uni::common::OperationStatus;
+using ::uni::common::PriorityQueue;
+using ::uni::common::MpmcQueue;
+using ::uni::common::Queue;
+using ::uni::common::QueueSet;
+using ::uni::common::RingBuffer;
+
+namespace
+{
+/// Copied on growth, since its move may throw. The copy throws once the budget is spent
+struct ThrowingCopy
+{
+    static int copy_budget;
+    static std::set< const ThrowingCopy* > alive;
+
+    explicit ThrowingCopy( int value_ )
+        : value{ value_ }
+    {
+        alive.insert( this );
+    }
+
+    ThrowingCopy( const ThrowingCopy& other )
+        : value{ other.value }
+    {
+        if( 0U == alive.count( &other ) )
+        {
+            throw std::logic_error( "copy of destroyed element" );
+        }
+        if( 0 == copy_budget-- )
+        {
+            throw std::runtime_error( "copy failed" );
+        }
+        alive.insert( this );
+    }
+
+    ThrowingCopy( ThrowingCopy&& other ) noexcept( false )
+        : ThrowingCopy( static_cast< const ThrowingCopy& >( other ) )
+    {
+    }
+
+    ~ThrowingCopy( )
+    {
+        alive.erase( this );
+    }
+
+    int value{ 0 };
+};
+
+int ThrowingCopy::copy_budget{ 0 };
+std::set< const ThrowingCopy* > ThrowingCopy::alive{};
+}  // namespace
+
+void
+QueueTest::SetUp( )
+{
+    ASSERT_NO_FATAL_FAILURE( Base::SetUp( ) );
+}
+
+void
+QueueTest::TearDown( )
+{
+    ASSERT_NO_FATAL_FAILURE( Base::TearDown( ) );
+}
+
+TEST_F( QueueTest, FifoAcrossWrapAndGrowth )
+{
+    Queue< std::string > queue;
+    int next_pop{ 0 };
+    std::string value;
+
+    // Head moves forward before the growth, so the ring is wrapped when it grows
+    for( int i = 0; i < 10; ++i )
+    {
+        queue.push( std::to_string( i ) );
+    }
+    for( ; next_pop < 8; ++next_pop )
+    {
+        ASSERT_EQ( OperationStatus::SUCCESS, queue.try_pop( value ) );
+        ASSERT_EQ( std::to_string( next_pop ), value );
+    }
+    for( int i = 10; i < 100; ++i )
+    {
+        queue.push( std::to_string( i ) );
+    }
+    for( ; next_pop < 100; ++next_pop )
+    {
+        ASSERT_EQ( OperationStatus::SUCCESS, queue.try_pop( value ) );
+        ASSERT_EQ( std::to_string( next_pop ), value );
+    }
+    ASSERT_TRUE( queue.empty( ) );
+}
+
+TEST_F( QueueTest, RingBufferGrowthRollsBack )
+{
+    {
+        RingBuffer< ThrowingCopy > ring;
+        const int count = static_cast< int >( RingBuffer< ThrowingCopy >::MIN_CAPACITY );
+        for( int i = 0; i < count; ++i )
+        {
+            ring.emplace_back( i );
+        }
+
+        // The growth fails in the middle, the ring keeps its elements and the half-built storage is released
+        ThrowingCopy::copy_budget = count / 2;
+        ASSERT_THROW( ring.emplace_back( count ), std::runtime_error );
+        ASSERT_EQ( static_cast< size_t >( count ), ring.size( ) );
+        ASSERT_EQ( static_cast< size_t >( count ), ThrowingCopy::alive.size( ) );
+
+        ThrowingCopy::copy_budget = count;
+        ring.emplace_back( count );
+        for( int i = 0; i <= count; ++i )
+        {
+            ASSERT_EQ( i, ring.front( ).value );
+            ring.pop_front( );
+        }
+    }
+    ASSERT_TRUE( ThrowingCopy::alive.empty( ) );
+}
+
+TEST_F( QueueTest, Backpressure )
+{
+    Queue< int > queue{ 2U };
+    ASSERT_EQ( 2U, queue.capacity( ) );
+    ASSERT_EQ( OperationStatus::SUCCESS, queue.try_push( 1 ) );
+    ASSERT_EQ( OperationStatus::SUCCESS, queue.push( 2 ) );
+    ASSERT_EQ( OperationStatus::UNSUCCESS, queue.try_push( 3 ) );
+    ASSERT_EQ( OperationStatus::UNSUCCESS, queue.push_for( 3, std::chrono::milliseconds( 10 ) ) );
+
+    // Blocked producer continues as soon as the consumer frees a slot
+    std::thread producer( [ &queue ] { ASSERT_EQ( OperationStatus::SUCCESS, queue.push( 3 ) ); } );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+    ASSERT_EQ( 2U, queue.size( ) );
+
+    int value{ 0 };
+    ASSERT_EQ( OperationStatus::SUCCESS, queue.wait_pop( value ) );
+    producer.join( );
+    ASSERT_EQ( 2U, queue.size( ) );
+
+    // Close releases the blocked producers
+    std::thread blocked( [ &queue ] { ASSERT_EQ( OperationStatus::CLOSED, queue.push( 4 ) ); } );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+    queue.close( );
+    blocked.join( );
+    ASSERT_EQ( 2U, queue.size( ) );
+}
+
+TEST_F( QueueTest, WaitPopFor )
+{
+    Queue< int > queue;
+    ASSERT_EQ( Queue< int >::UNBOUNDED, queue.capacity( ) );
+
+    int value{ 0 };
+    const auto start = std::chrono::steady_clock::now( );
+    ASSERT_EQ( OperationStatus::UNSUCCESS, queue.wait_pop_for( value, std::chrono::milliseconds( 20 ) ) );
+    ASSERT_GE( std::chrono::steady_clock::now( ) - start, std::chrono::milliseconds( 20 ) );
+
+    std::thread producer( [ &queue ] {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        queue.push( 7 );
+    } );
+    ASSERT_EQ( OperationStatus::SUCCESS, queue.wait_pop_for( value, std::chrono::seconds( 10 ) ) );
+    ASSERT_EQ( 7, value );
+    producer.join( );
+
+    // Spinning consumer falls back to the blocking wait
+    std::thread late_producer( [ &queue ] {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        queue.push( 8 );
+    } );
+    ASSERT_EQ( OperationStatus::SUCCESS, queue.spin_wait_pop( value ) );
+    ASSERT_EQ( 8, value );
+    late_producer.join( );
+
+    queue.close( );
+    ASSERT_EQ( OperationStatus::CLOSED, queue.wait_pop_for( value, std::chrono::seconds( 10 ) ) );
+}
+
+TEST_F( QueueTest, Bulk )
+{
+    Queue< int > queue{ 4U };
+    std::vector< int > input{ 1, 2, 3, 4, 5, 6 };
+
+    // Second half waits until the consumer frees the slots
+    std::thread producer( [ & ] { ASSERT_EQ( OperationStatus::SUCCESS, queue.push_bulk( input.begin( ), input.end( ) ) ); } );
+
+    std::vector< int > output;
+    while( output.size( ) < input.size( ) )
+    {
+        ASSERT_LT( 0U, queue.wait_pop_bulk( std::back_inserter( output ), 3U ) );
+    }
+    producer.join( );
+    ASSERT_EQ( input.size( ), output.size( ) );
+    ASSERT_EQ( 0U, queue.pop_bulk( std::back_inserter( output ), 3U ) );
+
+    queue.close( );
+    ASSERT_EQ( 0U, queue.wait_pop_bulk( std::back_inserter( output ), 3U ) );
+    ASSERT_EQ( OperationStatus::CLOSED, queue.push_bulk( input.begin( ), input.end( ) ) );
+}
+
+TEST_F( QueueTest, QueueSetSelect )
+{
+    Queue< int > queue;
+    MpmcQueue< int > mpmc_queue{ 16U };
+    QueueSet< int > queue_set;
+    ASSERT_EQ( 0U, queue_set.add( queue, 2U ) );
+    ASSERT_EQ( 1U, queue_set.add( mpmc_queue ) );
+
+    // Weighted round robin: two from the first queue, one from the second
+    for( int i = 0; i < 3; ++i )
+    {
+        queue.push( i );
+        mpmc_queue.push( 10 + i );
+    }
+    int value{ 0 };
+    size_t index{ 0U };
+    std::vector< size_t > order;
+    while( OperationStatus::SUCCESS == queue_set.try_pop( value, index ) )
+    {
+        order.push_back( index );
+    }
+    ASSERT_EQ( ( std::vector< size_t >{ 0U, 0U, 1U, 0U, 1U, 1U } ), order );
+
+    ASSERT_EQ( OperationStatus::UNSUCCESS, queue_set.wait_pop_for( value, index, std::chrono::milliseconds( 10 ) ) );
+
+    // Blocked consumer wakes up on the push to any queue
+    std::thread producer( [ & ] {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+        mpmc_queue.push( 42 );
+    } );
+    ASSERT_EQ( OperationStatus::SUCCESS, queue_set.wait_pop( value, index ) );
+    ASSERT_EQ( 42, value );
+    ASSERT_EQ( 1U, index );
+    producer.join( );
+
+    // CLOSED only when all the queues are closed
+    std::thread closer( [ & ] {
+        queue.close( );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+        mpmc_queue.close( );
+    } );
+    ASSERT_EQ( OperationStatus::CLOSED, queue_set.wait_pop( value, index ) );
+    closer.join( );
+}
+
+TEST_F( QueueTest, PriorityQueueStableOrder )
+{
+    using Item = std::pair< int, int >;  // Priority and push order
+    struct ByPriority
+    {
+        bool
+        operator( )( const Item& lhs, const Item& rhs ) const
+        {
+            return lhs.first < rhs.first;
+        }
+    };
+
+    PriorityQueue< Item, ByPriority > queue;
+    std::mt19937 random{ 42U };
+    for( int i = 0; i < 1000; ++i )
+    {
+        queue.push( Item{ static_cast< int >( random( ) % 10U ), i } );
+    }
+
+    std::vector< Item > items;
+    ASSERT_EQ( 10U, queue.pop_bulk( std::back_inserter( items ), 10U ) );
+    Item item;
+    while( OperationStatus::SUCCESS == queue.try_pop( item ) )
+    {
+        items.push_back( item );
+    }
+
+    ASSERT_EQ( 1000U, items.size( ) );
+    for( size_t i = 1U; i < items.size( ); ++i )
+    {
+        ASSERT_TRUE( ( items[ i - 1U ].first > items[ i ].first )
+                     || ( ( items[ i - 1U ].first == items[ i ].first ) && ( items[ i - 1U ].second < items[ i ].second ) ) );
+    }
+}
+
+}  // namespace common
+}  // namespace uni
+}  // namespace test
@@ -0,0 +1,37 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file test/uni/common/QueueTest.hpp
+/// @brief Declaration thread safe queue test class.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <uni/common/Queue.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace test
+{
+namespace uni
+{
+namespace common
+{
+class QueueTest : public testing::Test
+{
+    using Base = testing::Test;
+
+public:
+    QueueTest( ) = default;
+    ~QueueTest( ) override = default;
+
+    // Test
+private:
+    void SetUp( ) override;
+    void TearDown( ) override;
+};
+
+}  // namespace common
+}  // namespace uni
+}  // namespace test
@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file test/uni/common/SpscQueueTest.cpp
+/// @brief Implementation wait-free SPSC queue test class.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SpscQueueTest.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace test
+{
+namespace uni
+{
+namespace common
+{
+using ::uni::common::OperationStatus;
+using ::uni::common::SpscQueue;
+
+void
+SpscQueueTest::SetUp( )
+{
+    ASSERT_NO_FATAL_FAILURE( Base::SetUp( ) );
+}
+
+void
+SpscQueueTest::TearDown( )
+{
+    ASSERT_NO_FATAL_FAILURE( Base::TearDown( ) );
+}
+
+TEST_F( SpscQueueTest, BoundedFifo )
+{
+    SpscQueue< std::unique_ptr< int > > queue{ 4U };
+    for( int i = 0; i < 4; ++i )
+    {
+        ASSERT_EQ( OperationStatus::SUCCESS, queue.try_push( std::make_unique< int >( i ) ) );
+    }
+
+    auto rejected = std::make_unique< int >( 4 );
+    ASSERT_EQ( OperationStatus::UNSUCCESS, queue.try_push( std::move( rejected ) ) );
+    ASSERT_NE( nullptr, rejected );
+
+    std::unique_ptr< int > value;
+    ASSERT_EQ( OperationStatus::SUCCESS, queue.try_pop( value ) );
+    ASSERT_EQ( 0, *value );
+
+    // The freed slot is reused after the wrap, the rest stay in the queue for the destructor
+    ASSERT_EQ( OperationStatus::SUCCESS, queue.try_push( std::move( rejected ) ) );
+    ASSERT_EQ( 4U, queue.size( ) );
+}
+
+TEST_F( SpscQueueTest, PipelineAndClose )
+{
+    constexpr uint64_t ITEM_COUNT{ 100000U };
+
+    // Small capacity keeps both sides blocking on full and empty
+    SpscQueue< uint64_t > queue{ 8U };
+    uint64_t expected{ 1U };
+    bool is_ordered{ true };
+    std::thread consumer( [ & ] {
+        uint64_t value{ 0U };
+        while( OperationStatus::SUCCESS == queue.wait_pop( value ) )
+        {
+            is_ordered = is_ordered && ( value == expected );
+            ++expected;
+        }
+    } );
+
+    for( uint64_t value = 1U; value <= ITEM_COUNT; ++value )
+    {
+        queue.push( value );
+    }
+
+    // Consumer is asleep on the empty queue by now, close has to wake it
+    std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+    queue.close( );
+    consumer.join( );
+
+    ASSERT_TRUE( is_ordered );
+    ASSERT_EQ( ITEM_COUNT + 1U, expected );
+    ASSERT_EQ( OperationStatus::CLOSED, queue.try_push( 0U ) );
+}
+
+TEST_F( SpscQueueTest, TryPushWakesSleepingConsumer )
+{
+    SpscQueue< int > queue{ 8U };
+    std::atomic< int > popped_count{ 0 };
+    std::thread consumer( [ & ] {
+        int value{ 0 };
+        while( OperationStatus::SUCCESS == queue.wait_pop( value ) )
+        {
+            ++popped_count;
+        }
+    } );
+
+    // The producer fences only since it saw the consumer asleep, the wakeup must not be lost around the switch
+    bool is_woken{ true };
+    for( int i = 1; ( i <= 3 ) && is_woken; ++i )
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+        EXPECT_EQ( OperationStatus::SUCCESS, queue.try_push( int{ i } ) );
+
+        const auto deadline = std::chrono::steady_clock::now( ) + std::chrono::seconds( 1 );
+        while( ( popped_count < i ) && ( std::chrono::steady_clock::now( ) < deadline ) )
+        {
+            std::this_thread::yield( );
+        }
+        is_woken = ( popped_count == i );
+    }
+
+    queue.close( );
+    consumer.join( );
+    ASSERT_TRUE( is_woken );
+}
+
+}  // namespace common
+}  // namespace uni
+}  // namespace test
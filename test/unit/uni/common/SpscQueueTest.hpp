@@ -0,0 +1,37 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file test/uni/common/SpscQueueTest.hpp
+/// @brief Declaration wait-free SPSC queue test class.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <uni/common/SpscQueue.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace test
+{
+namespace uni
+{
+namespace common
+{
+class SpscQueueTest : public testing::Test
+{
+    using Base = testing::Test;
+
+public:
+    SpscQueueTest( ) = default;
+    ~SpscQueueTest( ) override = default;
+
+    // Test
+private:
+    void SetUp( ) override;
+    void TearDown( ) override;
+};
+
+}  // namespace common
+}  // namespace uni
+}  // namespace test
@@ -0,0 +1,700 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file test/uni/common/ThreadPoolTest.cpp
+/// @brief Implementation thread pool test class.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadPoolTest.hpp"
+
+#include <uni/common/ErrorCode.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <thread>
+
+#if defined( __linux__ )
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
+{
+const std::string NAME_TEST_POOL{ "TEST_Pool" };
+constexpr uint32_t TEST_THREAD_COUNT{ 4U };
+constexpr uint32_t TEST_TASK_COUNT{ 1000U };
+constexpr auto TEST_WAIT_TIMEOUT{ std::chrono::seconds( 10 ) };
+
+using ::uni::common::CpuSet;
+
+#if defined( __linux__ )
+CpuSet
+get_current_affinity( )
+{
+    cpu_set_t mask;
+    CPU_ZERO( &mask );
+    CpuSet cpu_set;
+    if( 0 == ::pthread_getaffinity_np( ::pthread_self( ), sizeof( mask ), &mask ) )
+    {
+        for( uint32_t cpu = 0U; cpu < CPU_SETSIZE; ++cpu )
+        {
+            if( CPU_ISSET( cpu, &mask ) )
+            {
+                cpu_set.add( cpu );
+            }
+        }
+    }
+    return cpu_set;
+}
+#endif
+
+/// The masks a worker may have under the policy, built from the topology independently of the pool
+std::vector< CpuSet >
+make_allowed_affinity( ::uni::common::ThreadPool::Placement policy, uint32_t worker_count )
+{
+    using Placement = ::uni::common::ThreadPool::Placement;
+
+    if( Placement::NUMA_NODE == policy )
+    {
+        return { ::uni::common::get_numa_node_cpus( 0U ) };
+    }
+
+    // Sorted by node, package, core: the first CPU of every core starts a new core id
+    const auto topology = ::uni::common::get_cpu_topology( );
+    std::vector< uint32_t > all_cpus;
+    std::vector< uint32_t > first_siblings;
+    for( size_t i = 0U; i < topology.size( ); ++i )
+    {
+        all_cpus.push_back( topology[ i ].cpu );
+        if( ( 0U == i ) || ( topology[ i ].node != topology[ i - 1U ].node ) || ( topology[ i ].package != topology[ i - 1U ].package )
+            || ( topology[ i ].core != topology[ i - 1U ].core ) )
+        {
+            first_siblings.push_back( topology[ i ].cpu );
+        }
+    }
+
+    std::vector< uint32_t > cpus;
+    switch( policy )
+    {
+        case( Placement::COMPACT ):
+            cpus.assign( all_cpus.begin( ), all_cpus.begin( ) + std::min< size_t >( worker_count, all_cpus.size( ) ) );
+            break;
+        case( Placement::PHYSICAL_CORES ):
+            cpus.assign( first_siblings.begin( ), first_siblings.begin( ) + std::min< size_t >( worker_count, first_siblings.size( ) ) );
+            break;
+        case( Placement::SCATTER ):
+            // Interleaved over the packages, only the first siblings are taken while there are enough cores
+            cpus = ( worker_count <= first_siblings.size( ) ) ? first_siblings : all_cpus;
+            break;
+        default:
+            break;
+    }
+
+    std::vector< CpuSet > allowed;
+    for( const uint32_t cpu : cpus )
+    {
+        allowed.push_back( CpuSet{ cpu } );
+    }
+    return allowed;
+}
+
+std::atomic< bool > g_is_counting_allocations{ false };
+std::atomic< uint64_t > g_allocation_count{ 0U };
+}  // namespace
+
+// Counts the heap allocations of every thread while g_is_counting_allocations is set
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"  // The replaced pair is malloc and free
+#endif
+
+void*
+operator new( std::size_t size )
+{
+    if( g_is_counting_allocations.load( std::memory_order_relaxed ) )
+    {
+        g_allocation_count.fetch_add( 1U, std::memory_order_relaxed );
+    }
+
+    if( void* memory = std::malloc( ( 0U == size ) ? 1U : size ) )
+    {
+        return memory;
+    }
+    throw std::bad_alloc( );
+}
+
+void
+operator delete( void* memory ) noexcept
+{
+    std::free( memory );
+}
+
+void
+operator delete( void* memory, std::size_t ) noexcept
+{
+    std::free( memory );
+}
+
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic pop
+#endif
+
+namespace test
+{
+namespace uni
+{
+namespace common
+{
+using ::uni::common::ErrorCode;
+using ::uni::common::ThreadPool;
+
+void
+ThreadPoolTest::SetUp( )
+{
+    ASSERT_NO_FATAL_FAILURE( Base::SetUp( ) );
+}
+
+void
+ThreadPoolTest::TearDown( )
+{
+    ASSERT_NO_FATAL_FAILURE( Base::TearDown( ) );
+}
+
+ThreadPool::Settings
+ThreadPoolTest::make_settings( uint32_t thread_count ) const
+{
+    ThreadPool::Settings settings{};
+    settings.thread_settings.name = NAME_TEST_POOL;
+    settings.thread_count = thread_count;
+    settings.scheduling = GetParam( );
+    return settings;
+}
+
+bool
+ThreadPoolTest::wait_for( const std::atomic< uint32_t >& counter, uint32_t expected )
+{
+    const auto deadline = std::chrono::steady_clock::now( ) + TEST_WAIT_TIMEOUT;
+    while( counter.load( ) < expected )
+    {
+        if( std::chrono::steady_clock::now( ) > deadline )
+        {
+            return false;
+        }
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    }
+    return true;
+}
+
+bool
+ThreadPoolTest::block_worker( ThreadPool& pool, const std::atomic< uint32_t >& gate )
+{
+    std::atomic< uint32_t > started{ 0U };
+    pool.submit( [ &started, &gate ] {
+        ++started;
+        wait_for( gate, 1U );
+    } );
+    return wait_for( started, 1U );
+}
+
+TEST_P( ThreadPoolTest, SimpleCtorDtor )
+{
+    ThreadPool pool{ make_settings( TEST_THREAD_COUNT ) };
+}
+
+TEST_P( ThreadPoolTest, SubmitRunsAllTasks )
+{
+    std::atomic< uint32_t > counter{ 0U };
+    ThreadPool pool{ make_settings( TEST_THREAD_COUNT ) };
+
+    for( uint32_t i = 0U; i < TEST_TASK_COUNT; ++i )
+    {
+        ASSERT_TRUE( pool.submit( [ &counter ] { ++counter; } ).valid( ) );
+    }
+
+    ASSERT_TRUE( wait_for( counter, TEST_TASK_COUNT ) );
+}
+
+TEST_P( ThreadPoolTest, SubmitStdFunction )
+{
+    std::atomic< uint32_t > counter{ 0U };
+    ThreadPool pool{ make_settings( TEST_THREAD_COUNT ) };
+
+    const ::uni::common::DefaultVoidStdFunction task = [ &counter ] { ++counter; };
+    ASSERT_EQ( ErrorCode::NONE, pool.submit( task ) );
+    ASSERT_TRUE( wait_for( counter, 1U ) );
+}
+
+TEST_P( ThreadPoolTest, SubmitReturnsResult )
+{
+    ThreadPool pool{ make_settings( TEST_THREAD_COUNT ) };
+
+    auto sum = pool.submit( []( uint32_t a, uint32_t b ) { return a + b; }, 2U, 3U );
+    auto text = pool.submit( [] { return std::string( "done" ); } );
+    auto nothing = pool.submit( [] {} );
+
+    ASSERT_EQ( 5U, sum.get( ) );
+    ASSERT_EQ( "done", text.get( ) );
+    ASSERT_NO_THROW( nothing.get( ) );
+}
+
+TEST_P( ThreadPoolTest, SubmitPropagatesException )
+{
+    ThreadPool pool{ make_settings( TEST_THREAD_COUNT ) };
+
+    auto future = pool.submit( []( ) -> uint32_t { throw std::runtime_error( "failed" ); } );
+    ASSERT_THROW( future.get( ), std::runtime_error );
+}
+
+TEST_P( ThreadPoolTest, SubmitMoveOnlyTask )
+{
+    ThreadPool pool{ make_settings( TEST_THREAD_COUNT ) };
+
+    auto value = std::make_unique< uint32_t >( 42U );
+    auto future = pool.submit( [ value = std::move( value ) ] { return *value; } );
+    ASSERT_EQ( 42U, future.get( ) );
+}
+
+TEST_P( ThreadPoolTest, SteadyStateSubmitDoesNotAllocate )
+{
+    constexpr uint32_t round_count{ 2U };
+
+    std::atomic< uint32_t > counter{ 0U };
+    ThreadPool pool{ make_settings( TEST_THREAD_COUNT ) };
+
+    // The workers are held while the round is queued, so every round reaches the same queue depth.
+    // The futures are dropped, the workers release the states: they go back to this thread's cache
+    const auto run_round = [ & ] {
+        std::atomic< uint32_t > gate{ 0U };
+        for( uint32_t i = 0U; i < TEST_THREAD_COUNT; ++i )
+        {
+            if( !block_worker( pool, gate ) )
+            {
+                return false;
+            }
+        }
+
+        counter = 0U;
+        for( uint32_t i = 0U; i < TEST_TASK_COUNT; ++i )
+        {
+            pool.submit( [ &counter ] { ++counter; } );
+        }
+        gate = 1U;
+        return wait_for( counter, TEST_TASK_COUNT ) && ( ErrorCode::NONE == pool.wait_idle( TEST_WAIT_TIMEOUT ) );
+    };
+
+    // The queues grow and the caches fill up in the first rounds
+    for( uint32_t round = 0U; round < round_count; ++round )
+    {
+        ASSERT_TRUE( run_round( ) );
+    }
+
+    g_allocation_count = 0U;
+    g_is_counting_allocations = true;
+    const bool is_done = run_round( );
+    g_is_counting_allocations = false;
+
+    ASSERT_TRUE( is_done );
+    ASSERT_EQ( 0U, g_allocation_count.load( ) );
+}
+
+TEST_P( ThreadPoolTest, ParkedWorkersWakeUp )
+{
+    auto settings = make_settings( TEST_THREAD_COUNT );
+    settings.idle.park_timeout_ms = std::chrono::milliseconds( TEST_WAIT_TIMEOUT ).count( );
+    ThreadPool pool{ settings };
+
+    for( uint32_t i = 0U; i < 10U; ++i )
+    {
+        // Let all the workers go to the park
+        std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+
+        auto future = pool.submit( [ i ] { return i; } );
+        ASSERT_TRUE( future.wait_for( std::chrono::seconds( 1 ) ) );
+        ASSERT_EQ( i, future.get( ) );
+    }
+}
+
+TEST_P( ThreadPoolTest, ElasticGrowAndShrink )
+{
+    constexpr uint32_t max_thread_count{ 4U };
+
+    auto settings = make_settings( 1U );
+    settings.elastic.min_thread_count = 1U;
+    settings.elastic.max_thread_count = max_thread_count;
+    settings.elastic.grow_wait_ms = 5U;
+    settings.elastic.keep_alive_ms = 20U;
+    settings.elastic.check_interval_ms = 1U;
+    settings.idle.park_timeout_ms = 10U;
+    ThreadPool pool{ settings };
+    ASSERT_EQ( 1U, pool.get_thread_count( ) );
+
+    // Every task blocks until all of them are started, only the grown pool could run them
+    std::atomic< uint32_t > started{ 0U };
+    for( uint32_t i = 0U; i < max_thread_count; ++i )
+    {
+        pool.submit( [ &started ] {
+            ++started;
+            wait_for( started, max_thread_count );
+        } );
+    }
+
+    ASSERT_TRUE( wait_for( started, max_thread_count ) );
+    ASSERT_EQ( max_thread_count, pool.get_thread_count( ) );
+
+    const auto deadline = std::chrono::steady_clock::now( ) + TEST_WAIT_TIMEOUT;
+    while( ( pool.get_thread_count( ) > 1U ) && ( std::chrono::steady_clock::now( ) < deadline ) )
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+    }
+    ASSERT_EQ( 1U, pool.get_thread_count( ) );
+
+    // The shrunk pool keeps working
+    ASSERT_EQ( 42U, pool.submit( [] { return 42U; } ).get( ) );
+}
+
+TEST_P( ThreadPoolTest, PriorityLanesOrder )
+{
+    auto settings = make_settings( 1U );
+    settings.priority_aging_ms = 0U;
+    ThreadPool pool{ settings };
+
+    // Keep the only worker busy until all the tasks are queued
+    std::atomic< uint32_t > gate{ 0U };
+    ASSERT_TRUE( block_worker( pool, gate ) );
+
+    std::mutex mutex;
+    std::vector< ThreadPool::Priority > order;
+    auto record = [ & ]( ThreadPool::Priority priority ) {
+        return [ &, priority ] {
+            std::lock_guard< std::mutex > lock( mutex );
+            order.push_back( priority );
+        };
+    };
+
+    auto low = pool.submit( record( ThreadPool::Priority::LOW ), ThreadPool::Priority::LOW );
+    auto normal = pool.submit( record( ThreadPool::Priority::NORMAL ), ThreadPool::Priority::NORMAL );
+    auto high = pool.submit( record( ThreadPool::Priority::HIGH ), ThreadPool::Priority::HIGH );
+
+    gate = 1U;
+    low.get( );
+    normal.get( );
+    high.get( );
+
+    const std::vector< ThreadPool::Priority > expected{ ThreadPool::Priority::HIGH, ThreadPool::Priority::NORMAL, ThreadPool::Priority::LOW };
+    ASSERT_EQ( expected, order );
+}
+
+TEST_P( ThreadPoolTest, PriorityAging )
+{
+    auto settings = make_settings( 1U );
+    settings.priority_aging_ms = 10U;
+    ThreadPool pool{ settings };
+
+    std::atomic< uint32_t > gate{ 0U };
+    ASSERT_TRUE( block_worker( pool, gate ) );
+
+    std::atomic< uint32_t > sequence{ 0U };
+    auto low = pool.submit( [ &sequence ] { return sequence++; }, ThreadPool::Priority::LOW );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+    auto high = pool.submit( [ &sequence ] { return sequence++; }, ThreadPool::Priority::HIGH );
+
+    gate = 1U;
+    ASSERT_EQ( 0U, low.get( ) );
+    ASSERT_EQ( 1U, high.get( ) );
+}
+
+TEST_P( ThreadPoolTest, ExpiredTaskIsDropped )
+{
+    ThreadPool pool{ make_settings( 1U ) };
+
+    std::atomic< uint32_t > gate{ 0U };
+    ASSERT_TRUE( block_worker( pool, gate ) );
+
+    std::atomic< uint32_t > counter{ 0U };
+    const auto deadline = ThreadPool::Clock::now( ) + std::chrono::milliseconds( 1 );
+    auto expired = pool.submit( [ &counter ] { ++counter; }, ThreadPool::Priority::HIGH, deadline );
+    auto alive = pool.submit( [ &counter ] { ++counter; }, ThreadPool::Priority::HIGH, deadline + std::chrono::hours( 1 ) );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+
+    gate = 1U;
+    ASSERT_THROW( expired.get( ), std::future_error );
+    ASSERT_NO_THROW( alive.get( ) );
+    ASSERT_EQ( 1U, counter.load( ) );
+    ASSERT_EQ( 1U, pool.get_expired_count( ) );
+}
+
+TEST_P( ThreadPoolTest, WorkerPlacement )
+{
+    for( const auto policy : { ThreadPool::Placement::COMPACT,
+                               ThreadPool::Placement::SCATTER,
+                               ThreadPool::Placement::PHYSICAL_CORES,
+                               ThreadPool::Placement::NUMA_NODE } )
+    {
+        std::atomic< uint32_t > counter{ 0U };
+        std::mutex mutex;
+        std::vector< CpuSet > observed;
+        auto settings = make_settings( TEST_THREAD_COUNT );
+        settings.placement.policy = policy;
+        ThreadPool pool{ settings };
+
+        for( uint32_t i = 0U; i < TEST_TASK_COUNT; ++i )
+        {
+            pool.submit( [ &counter, &mutex, &observed ] {
+#if defined( __linux__ )
+                const CpuSet affinity = get_current_affinity( );
+                std::lock_guard< std::mutex > lock{ mutex };
+                if( std::find( observed.begin( ), observed.end( ), affinity ) == observed.end( ) )
+                {
+                    observed.push_back( affinity );
+                }
+#endif
+                ++counter;
+            } );
+        }
+        ASSERT_TRUE( wait_for( counter, TEST_TASK_COUNT ) ) << policy;
+
+        const auto allowed = make_allowed_affinity( policy, TEST_THREAD_COUNT );
+        std::lock_guard< std::mutex > lock{ mutex };
+#if defined( __linux__ )
+        ASSERT_FALSE( observed.empty( ) ) << policy;
+#endif
+        for( const auto& affinity : observed )
+        {
+            ASSERT_NE( allowed.end( ), std::find( allowed.begin( ), allowed.end( ), affinity ) ) << policy << " " << affinity;
+        }
+    }
+}
+
+TEST_P( ThreadPoolTest, SubmitAfterAndEvery )
+{
+    std::atomic< uint32_t > delayed{ 0U };
+    std::atomic< uint32_t > periodic{ 0U };
+    std::atomic< uint32_t > cancelled{ 0U };
+    ThreadPool pool{ make_settings( TEST_THREAD_COUNT ) };
+
+    const auto start = std::chrono::steady_clock::now( );
+    ASSERT_TRUE( pool.submit_after( std::chrono::milliseconds( 20 ), [ &delayed ] { ++delayed; } ).valid( ) );
+    const auto every = pool.submit_every( std::chrono::milliseconds( 5 ), [ &periodic ] { ++periodic; } );
+    const auto never = pool.submit_after( std::chrono::seconds( 1 ), [ &cancelled ] { ++cancelled; } );
+
+    ASSERT_EQ( ErrorCode::NONE, pool.cancel( never ) );
+    ASSERT_EQ( ErrorCode::NOT_FOUND, pool.cancel( never ) );
+
+    ASSERT_TRUE( wait_for( delayed, 1U ) );
+    ASSERT_GE( std::chrono::steady_clock::now( ) - start, std::chrono::milliseconds( 20 ) );
+
+    ASSERT_TRUE( wait_for( periodic, 3U ) );
+    ASSERT_EQ( ErrorCode::NONE, pool.cancel( every ) );
+    ASSERT_EQ( 0U, cancelled.load( ) );
+}
+
+TEST_P( ThreadPoolTest, Metrics )
+{
+    std::atomic< uint32_t > counter{ 0U };
+    auto settings = make_settings( TEST_THREAD_COUNT );
+    settings.enable_metrics = true;
+    ThreadPool pool{ settings };
+
+    for( uint32_t i = 0U; i < TEST_TASK_COUNT; ++i )
+    {
+        pool.submit( [ &counter ] {
+            std::this_thread::sleep_for( std::chrono::microseconds( 10 ) );
+            ++counter;
+        } );
+    }
+    ASSERT_TRUE( wait_for( counter, TEST_TASK_COUNT ) );
+
+    // The counter is incremented inside the task, the last run time is recorded right after
+    ThreadPool::Metrics metrics;
+    const auto deadline = std::chrono::steady_clock::now( ) + TEST_WAIT_TIMEOUT;
+    do
+    {
+        metrics = pool.get_metrics( );
+    } while( ( metrics.run_time.get_count( ) < TEST_TASK_COUNT ) && ( std::chrono::steady_clock::now( ) < deadline ) );
+
+    ASSERT_EQ( TEST_TASK_COUNT, metrics.run_time.get_count( ) );
+    ASSERT_EQ( TEST_TASK_COUNT, metrics.wait_time.get_count( ) );
+    ASSERT_EQ( TEST_THREAD_COUNT, metrics.workers.size( ) );
+    ASSERT_GE( metrics.run_time.get_percentile( 0.5 ), 10000U );
+    ASSERT_LE( metrics.run_time.get_percentile( 0.5 ), metrics.run_time.get_percentile( 0.99 ) );
+    ASSERT_EQ( TEST_TASK_COUNT, metrics.normal_lane.push_count );
+
+    std::stringstream stream;
+    stream << metrics;
+    ASSERT_NE( std::string::npos, stream.str( ).find( "p99_ns" ) );
+}
+
+TEST_P( ThreadPoolTest, WaitIdle )
+{
+    std::atomic< uint32_t > counter{ 0U };
+    ThreadPool pool{ make_settings( TEST_THREAD_COUNT ) };
+
+    ASSERT_EQ( ErrorCode::NONE, pool.wait_idle( ) );
+
+    for( uint32_t i = 0U; i < TEST_TASK_COUNT; ++i )
+    {
+        pool.submit( [ &counter ] { ++counter; } );
+    }
+    ASSERT_EQ( ErrorCode::NONE, pool.wait_idle( ) );
+    ASSERT_EQ( TEST_TASK_COUNT, counter.load( ) );
+
+    std::atomic< uint32_t > gate{ 0U };
+    ASSERT_TRUE( block_worker( pool, gate ) );
+    ASSERT_EQ( ErrorCode::TIMEOUT, pool.wait_idle( std::chrono::milliseconds( 10 ) ) );
+    gate = 1U;
+    ASSERT_EQ( ErrorCode::NONE, pool.wait_idle( ) );
+}
+
+TEST_P( ThreadPoolTest, ShutdownDrain )
+{
+    std::atomic< uint32_t > counter{ 0U };
+    ThreadPool pool{ make_settings( TEST_THREAD_COUNT ) };
+
+    // Every task submits one more from the worker, the drain runs them too
+    for( uint32_t i = 0U; i < TEST_TASK_COUNT; ++i )
+    {
+        pool.submit( [ &pool, &counter ] {
+            ++counter;
+            pool.submit( [ &counter ] { ++counter; } );
+        } );
+    }
+
+    const auto stats = pool.shutdown( ThreadPool::ShutdownMode::DRAIN );
+    ASSERT_EQ( 2U * TEST_TASK_COUNT, counter.load( ) );
+    ASSERT_EQ( 2U * TEST_TASK_COUNT, stats.completed_count );
+    ASSERT_EQ( 0U, stats.dropped_count );
+
+    ASSERT_EQ( ErrorCode::INTERNAL, pool.submit( ::uni::common::DefaultVoidStdFunction{ [] {} } ) );
+}
+
+TEST_P( ThreadPoolTest, ShutdownTimeoutDropsQueuedTasks )
+{
+    ThreadPool pool{ make_settings( 1U ) };
+
+    std::atomic< uint32_t > gate{ 0U };
+    ASSERT_TRUE( block_worker( pool, gate ) );
+
+    std::vector< ::uni::common::TaskFuture< uint32_t > > futures;
+    for( uint32_t i = 0U; i < TEST_THREAD_COUNT; ++i )
+    {
+        futures.push_back( pool.submit( [ i ] { return i; } ) );
+    }
+
+    // The blocked task is released after the timeout, it still finishes
+    std::thread releaser( [ &gate ] {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+        gate = 1U;
+    } );
+    const auto stats = pool.shutdown( ThreadPool::ShutdownMode::TIMEOUT, std::chrono::milliseconds( 10 ) );
+    releaser.join( );
+
+    ASSERT_TRUE( stats.is_timed_out );
+    ASSERT_EQ( 1U, stats.completed_count );
+    ASSERT_EQ( TEST_THREAD_COUNT, stats.dropped_count );
+    for( auto& future : futures )
+    {
+        ASSERT_THROW( future.get( ), std::future_error );
+    }
+}
+
+TEST_P( ThreadPoolTest, ShutdownCancelStopsAllWorkers )
+{
+    constexpr uint32_t worker_count{ 2U };
+
+    std::atomic< uint32_t > counter{ 0U };
+    ThreadPool pool{ make_settings( worker_count ) };
+
+    std::atomic< uint32_t > gate{ 0U };
+    for( uint32_t i = 0U; i < worker_count; ++i )
+    {
+        ASSERT_TRUE( block_worker( pool, gate ) );
+    }
+
+    for( uint32_t i = 0U; i < TEST_TASK_COUNT; ++i )
+    {
+        pool.submit( [ &counter ] { ++counter; } );
+    }
+
+    // While the first worker is joined the second one is already stopped, it does not pick up the queued tasks
+    std::thread releaser( [ &gate ] {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+        gate = 1U;
+    } );
+    const auto stats = pool.shutdown( ThreadPool::ShutdownMode::CANCEL );
+    releaser.join( );
+
+    ASSERT_EQ( 0U, counter.load( ) );
+    ASSERT_EQ( worker_count, stats.completed_count );
+    ASSERT_EQ( TEST_TASK_COUNT, stats.dropped_count );
+}
+
+TEST_P( ThreadPoolTest, SubmitConcurrentWithShutdown )
+{
+    constexpr uint32_t submitter_count{ 4U };
+
+    std::atomic< uint32_t > counter{ 0U };
+    std::atomic< uint32_t > accepted{ 0U };
+    ThreadPool pool{ make_settings( TEST_THREAD_COUNT ) };
+
+    // Every accepted task is either run or dropped, a rejected one is neither
+    std::vector< std::thread > submitters;
+    for( uint32_t i = 0U; i < submitter_count; ++i )
+    {
+        submitters.emplace_back( [ &pool, &counter, &accepted ] {
+            const ::uni::common::DefaultVoidStdFunction task = [ &counter ] { ++counter; };
+            while( ErrorCode::NONE == pool.submit( task ) )
+            {
+                ++accepted;
+            }
+        } );
+    }
+
+    ASSERT_TRUE( wait_for( accepted, TEST_TASK_COUNT ) );
+    const auto stats = pool.shutdown( ThreadPool::ShutdownMode::CANCEL );
+    for( auto& submitter : submitters )
+    {
+        submitter.join( );
+    }
+
+    ASSERT_EQ( counter.load( ), stats.completed_count );
+    ASSERT_EQ( accepted.load( ), stats.completed_count + stats.dropped_count );
+    ASSERT_EQ( ErrorCode::NONE, pool.wait_idle( std::chrono::milliseconds( 0 ) ) );  // No task is counted twice or lost
+}
+
+TEST_P( ThreadPoolTest, NestedSubmitFromWorker )
+{
+    constexpr uint32_t depth{ 10U };
+    constexpr uint32_t expected{ ( 1U << ( depth + 1U ) ) - 1U };
+
+    std::atomic< uint32_t > counter{ 0U };
+    ThreadPool pool{ make_settings( TEST_THREAD_COUNT ) };
+
+    // Binary fan-out, every task submits two children
+    std::function< void( uint32_t ) > fan_out = [ & ]( uint32_t level ) {
+        ++counter;
+        if( level < depth )
+        {
+            pool.submit( fan_out, level + 1U );
+            pool.submit( fan_out, level + 1U );
+        }
+    };
+
+    ASSERT_TRUE( pool.submit( fan_out, 0U ).valid( ) );
+    ASSERT_TRUE( wait_for( counter, expected ) );
+}
+
+INSTANTIATE_TEST_SUITE_P( Scheduling,
+                          ThreadPoolTest,
+                          testing::Values( ThreadPool::Scheduling::SHARED_QUEUE, ThreadPool::Scheduling::WORK_STEALING ) );
+
+}  // namespace common
+}  // namespace uni
+}  // namespace test
@@ -0,0 +1,49 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file test/uni/common/ThreadPoolTest.hpp
+/// @brief Declaration thread pool test class.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <uni/common/ThreadPool.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+
+namespace test
+{
+namespace uni
+{
+namespace common
+{
+class ThreadPoolTest : public testing::TestWithParam< ::uni::common::ThreadPool::Scheduling >
+{
+    using Base = testing::TestWithParam< ::uni::common::ThreadPool::Scheduling >;
+
+public:
+    ThreadPoolTest( ) = default;
+    ~ThreadPoolTest( ) override = default;
+
+    // Test
+private:
+    void SetUp( ) override;
+    void TearDown( ) override;
+
+protected:
+    ::uni::common::ThreadPool::Settings make_settings( uint32_t thread_count ) const;
+
+    /// Waits until counter reaches expected value, returns false on timeout
+    static bool wait_for( const std::atomic< uint32_t >& counter, uint32_t expected );
+
+    /// Occupies one worker until the gate is set to 1
+    static bool block_worker( ::uni::common::ThreadPool& pool, const std::atomic< uint32_t >& gate );
+};
+
+}  // namespace common
+}  // namespace uni
+}  // namespace test
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file test/uni/common/TimerWheelTest.cpp
+/// @brief Implementation timer wheel test class.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "TimerWheelTest.hpp"
+
+namespace test
+{
+namespace uni
+{
+namespace common
+{
+using ::uni::common::Task;
+using ::uni::common::TimerWheel;
+
+void
+TimerWheelTest::SetUp( )
+{
+    ASSERT_NO_FATAL_FAILURE( Base::SetUp( ) );
+}
+
+void
+TimerWheelTest::TearDown( )
+{
+    ASSERT_NO_FATAL_FAILURE( Base::TearDown( ) );
+}
+
+void
+TimerWheelTest::advance_to( uint64_t ms )
+{
+    m_wheel.advance( m_start + std::chrono::milliseconds( ms ), []( Task&& task ) { task( ); } );
+}
+
+TimerWheel::Handle
+TimerWheelTest::add( uint64_t due_ms, uint64_t period_ms, uint32_t id )
+{
+    return m_wheel.add( m_start + std::chrono::milliseconds( due_ms ), std::chrono::milliseconds( period_ms ), [ this, id ] {
+        m_fired.push_back( id );
+    } );
+}
+
+TEST_F( TimerWheelTest, FiresInDueOrder )
+{
+    // Spread over the levels: the finest wheel, the second and the third one
+    add( 70000U, 0U, 4U );
+    add( 300U, 0U, 2U );
+    add( 5U, 0U, 1U );
+    add( 1000U, 0U, 3U );
+    ASSERT_EQ( 4U, m_wheel.size( ) );
+
+    advance_to( 4U );
+    ASSERT_TRUE( m_fired.empty( ) );
+
+    advance_to( 1000U );
+    ASSERT_EQ( ( std::vector< uint32_t >{ 1U, 2U, 3U } ), m_fired );
+
+    advance_to( 69999U );
+    ASSERT_EQ( 3U, m_fired.size( ) );
+
+    advance_to( 70000U );
+    ASSERT_EQ( ( std::vector< uint32_t >{ 1U, 2U, 3U, 4U } ), m_fired );
+    ASSERT_TRUE( m_wheel.empty( ) );
+}
+
+TEST_F( TimerWheelTest, Cancel )
+{
+    const auto first = add( 10U, 0U, 1U );
+    const auto second = add( 500U, 0U, 2U );
+
+    ASSERT_TRUE( m_wheel.cancel( second ) );
+    ASSERT_FALSE( m_wheel.cancel( second ) );
+
+    advance_to( 1000U );
+    ASSERT_EQ( ( std::vector< uint32_t >{ 1U } ), m_fired );
+
+    // Fired timer can not be cancelled, its slot reused by a new timer is not affected by the old handle
+    ASSERT_FALSE( m_wheel.cancel( first ) );
+    const auto third = add( 1100U, 0U, 3U );
+    ASSERT_FALSE( m_wheel.cancel( first ) );
+    ASSERT_TRUE( m_wheel.cancel( third ) );
+    ASSERT_TRUE( m_wheel.empty( ) );
+}
+
+TEST_F( TimerWheelTest, Periodic )
+{
+    const auto handle = add( 10U, 10U, 1U );
+
+    advance_to( 10U );
+    advance_to( 20U );
+    advance_to( 35U );
+    ASSERT_EQ( 3U, m_fired.size( ) );
+
+    // Periods missed by the late advance are coalesced into one fire
+    advance_to( 1000U );
+    ASSERT_EQ( 4U, m_fired.size( ) );
+
+    ASSERT_TRUE( m_wheel.cancel( handle ) );
+    advance_to( 2000U );
+    ASSERT_EQ( 4U, m_fired.size( ) );
+}
+
+TEST_F( TimerWheelTest, NextExpiry )
+{
+    ASSERT_EQ( TimerWheel::Clock::time_point::max( ), m_wheel.get_next_expiry( ) );
+
+    add( 20U, 0U, 1U );
+    ASSERT_EQ( m_start + std::chrono::milliseconds( 20 ), m_wheel.get_next_expiry( ) );
+}
+
+}  // namespace common
+}  // namespace uni
+}  // namespace test
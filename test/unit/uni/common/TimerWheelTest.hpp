@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file test/uni/common/TimerWheelTest.hpp
+/// @brief Declaration timer wheel test class.
+/// @author Sergey Polyakov <white.irbys@gmail.com>
+/// @date 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <uni/common/TimerWheel.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+namespace test
+{
+namespace uni
+{
+namespace common
+{
+class TimerWheelTest : public testing::Test
+{
+    using Base = testing::Test;
+
+public:
+    TimerWheelTest( ) = default;
+    ~TimerWheelTest( ) override = default;
+
+    // Test
+private:
+    void SetUp( ) override;
+    void TearDown( ) override;
+
+protected:
+    /// Moves the wheel to start + ms and runs the fired tasks
+    void advance_to( uint64_t ms );
+
+    /// Adds the timer recording its id into m_fired
+    ::uni::common::TimerWheel::Handle add( uint64_t due_ms, uint64_t period_ms, uint32_t id );
+
+protected:
+    const ::uni::common::TimerWheel::Clock::time_point m_start{ ::uni::common::TimerWheel::Clock::now( ) };
+    ::uni::common::TimerWheel m_wheel{ std::chrono::milliseconds( 1 ), m_start };
+    std::vector< uint32_t > m_fired{};
+};
+
+}  // namespace common
+}  // namespace uni
+}  // namespace test